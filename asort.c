@@ -0,0 +1,86 @@
+/* asort.c
+ * ECE 2230 Fall 2025
+ * MP3 — background snapshot sort
+ *
+ * Purpose:
+ *   Double-buffered queue.  The snapshot list is owned by the worker
+ *   thread from asort_start until the join in asort_finish; the main
+ *   thread only touches the (fresh, empty) queue in between, so no
+ *   locking is needed.
+ */
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "asort.h"
+
+struct asort_tag {
+    llist_t *snapshot;
+    void (*sortfn)(llist_t *, int);
+    int sort_type;
+    double sort_ms;      /* written by the worker, read after the join */
+    pthread_t worker;
+};
+
+static double ms_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+static void *worker_main(void *argp)
+{
+    asort_t *a = (asort_t *) argp;
+    double t0 = ms_now();
+    a->sortfn(a->snapshot, a->sort_type);
+    a->sort_ms = ms_now() - t0;
+    return NULL;
+}
+
+asort_t *asort_start(llist_t *queue, void (*sortfn)(llist_t *, int), int sort_type)
+{
+    assert(queue && sortfn);
+    asort_t *a = (asort_t *) calloc(1, sizeof(asort_t));
+    assert(a);
+    a->snapshot = llist_construct(NULL);
+    llist_splice(a->snapshot, queue);
+    a->sortfn = sortfn;
+    a->sort_type = sort_type;
+
+    int rc = pthread_create(&a->worker, NULL, worker_main, a);
+    assert(rc == 0);
+    return a;
+}
+
+void asort_finish(asort_t *a, llist_t *queue, int merge, int *n_sorted, double *sort_ms)
+{
+    assert(a && queue && n_sorted && sort_ms);
+    pthread_join(a->worker, NULL);
+    *n_sorted = llist_entries(a->snapshot);
+
+    double t0 = ms_now();
+    if (merge) {
+        a->sortfn(queue, a->sort_type);
+        llist_merge(a->snapshot, queue);
+    } else {
+        llist_splice(a->snapshot, queue);
+    }
+    /* queue is empty here, so it takes the snapshot's sorted state too */
+    llist_splice(queue, a->snapshot);
+    *sort_ms = a->sort_ms + (ms_now() - t0);
+
+    llist_destruct(a->snapshot);
+    free(a);
+}
+
+int asort_type(const asort_t *a)
+{
+    assert(a);
+    return a->sort_type;
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,29 @@
+/* asort.h
+ * Background snapshot sort for lab3's ASORTGEN / ASORTIP / AWAIT
+ *
+ * asort_start detaches the queue's whole chain as a snapshot and sorts it
+ * on a worker thread; the queue is left empty and keeps taking appends.
+ * asort_finish waits for the worker and publishes the sorted snapshot
+ * ahead of everything appended since, or merges the new arrivals in.
+ */
+#ifndef ASORT_H
+#define ASORT_H
+
+#include "llist.h"
+
+typedef struct asort_tag asort_t;
+
+/* sortfn(snapshot, sort_type) runs on the worker, as ids_sort_gen does */
+asort_t * asort_start(llist_t *queue, void (*sortfn)(llist_t *, int), int sort_type);
+
+/* Join the worker and put the snapshot back at the front of queue.  With
+ * merge set, the arrivals are sorted with the same sortfn and merged in,
+ * so the queue ends up fully sorted (identical to a synchronous sort of
+ * everything when sort_type is stable).  Reports the snapshot size and
+ * the time spent sorting and merging; frees a.
+ */
+void      asort_finish(asort_t *a, llist_t *queue, int merge, int *n_sorted, double *sort_ms);
+
+int       asort_type(const asort_t *a);
+
+#endif
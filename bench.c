@@ -0,0 +1,1210 @@
+/* bench.c
+ * ECE 2230 Fall 2025
+ * MP3 benchmark driver
+ *
+ * Purpose: in-process measurements of the list backends, so timings do
+ *          not include geninput's pipe or lab3's parsing.
+ *
+ * Usage:
+ *     ./bench                       list the available suites
+ *     ./bench <suite> [N] [seed] [dist]   run one suite; dist is a
+ *                                   workload.h type (name or number) for
+ *                                   the suite's records
+ *
+ * Every suite prints tab-separated "suite  metric  backend  value  unit"
+ * rows on stdout so two builds can be compared with diff or join.
+ */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "ids_support.h"
+#include "ullist.h"
+#include "ilist.h"
+#include "ingest.h"
+#include "colstore.h"
+#include "simdsort.h"
+#include "retain.h"
+#include "workload.h"
+#include "recout.h"
+#include "coldtier.h"
+
+#define DEFAULT_N     500000
+#define DEFAULT_SEED  1473633460
+
+static double ms_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+static size_t heap_in_use(void)
+{
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+}
+
+static void report(const char *suite, const char *metric, const char *backend,
+                   double value, const char *unit)
+{
+    printf("%s\t%s\t%s\t%.3f\t%s\n", suite, metric, backend, value, unit);
+}
+
+static int bench_dist;   /* workload type from the command line, 0 for the default keys */
+
+struct record_array {
+    alert_t **recs;
+    int count;
+};
+
+static void collect_record(int generator_id, int dest_ip_addr, void *arg)
+{
+    struct record_array *a = (struct record_array *) arg;
+    alert_t *rec = (alert_t *) calloc(1, sizeof(alert_t));
+    rec->generator_id = generator_id;
+    rec->dest_ip_addr = dest_ip_addr;
+    a->recs[a->count++] = rec;
+}
+
+static void append_record(int generator_id, int dest_ip_addr, void *arg)
+{
+    alert_t *rec = (alert_t *) calloc(1, sizeof(alert_t));
+    rec->generator_id = generator_id;
+    rec->dest_ip_addr = dest_ip_addr;
+    llist_insert((llist_t *) arg, rec, LLPOSITION_BACK);
+}
+
+/* records shared by every backend in a suite, keyed like geninput type 1
+ * unless a distribution was given
+ */
+static alert_t **make_records(int n, long seed)
+{
+    alert_t **recs = (alert_t **) malloc(n * sizeof(alert_t *));
+    if (bench_dist) {
+        struct record_array a = { recs, 0 };
+        workload_generate(bench_dist, n, 0, 0.0, seed, collect_record, &a);
+        return recs;
+    }
+    srand48(seed);
+    for (int i = 0; i < n; i++) {
+        recs[i] = (alert_t *) calloc(1, sizeof(alert_t));
+        recs[i]->generator_id = (int) (n / 2 * drand48()) + 1;
+        recs[i]->dest_ip_addr = (int) (10 * n * drand48()) + n + 1;
+    }
+    return recs;
+}
+
+/* ===== unrolled vs doubly linked ===== */
+
+static long walk_llist(llist_t *L)
+{
+    long sum = 0;
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) sum += r->data_ptr->generator_id;
+    return sum;
+}
+
+static long walk_ullist(ullist_t *L)
+{
+    long sum = 0;
+    for (ullist_block_t *b = L->ul_front; b; b = b->ul_next)
+        for (int i = 0; i < b->ul_count; i++) sum += b->ul_data[i]->generator_id;
+    return sum;
+}
+
+static int bench_unrolled(int n, long seed)
+{
+    const int walks = 10, probes = 2000;
+    alert_t **recs = make_records(n, seed);
+
+    size_t h0 = heap_in_use();
+    llist_t *dl = llist_construct(NULL);
+    for (int i = 0; i < n; i++) llist_insert(dl, recs[i], LLPOSITION_BACK);
+    size_t h1 = heap_in_use();
+    ullist_t *ul = ullist_construct(NULL);
+    for (int i = 0; i < n; i++) ullist_insert(ul, recs[i], LLPOSITION_BACK);
+    size_t h2 = heap_in_use();
+
+    report("unrolled", "bytes_per_elem", "llist", (double)(h1 - h0) / n, "B");
+    report("unrolled", "bytes_per_elem", "ullist", (double)(h2 - h1) / n, "B");
+
+    long s1 = 0, s2 = 0;
+    double t0 = ms_now();
+    for (int w = 0; w < walks; w++) s1 += walk_llist(dl);
+    double t1 = ms_now();
+    for (int w = 0; w < walks; w++) s2 += walk_ullist(ul);
+    double t2 = ms_now();
+    if (s1 != s2) { fprintf(stderr, "bench: walk mismatch\n"); exit(1); }
+    report("unrolled", "walk_ns_per_elem", "llist", (t1 - t0) * 1e6 / ((double)walks * n), "ns");
+    report("unrolled", "walk_ns_per_elem", "ullist", (t2 - t1) * 1e6 / ((double)walks * n), "ns");
+
+    srand48(seed + 1);
+    int *pos = (int *) malloc(probes * sizeof(int));
+    for (int i = 0; i < probes; i++) pos[i] = (int) (n * drand48());
+    t0 = ms_now();
+    for (int i = 0; i < probes; i++) s1 += llist_access(dl, pos[i])->generator_id;
+    t1 = ms_now();
+    for (int i = 0; i < probes; i++) s2 += ullist_access(ul, pos[i])->generator_id;
+    t2 = ms_now();
+    report("unrolled", "access_us", "llist", (t1 - t0) * 1e3 / probes, "us");
+    report("unrolled", "access_us", "ullist", (t2 - t1) * 1e3 / probes, "us");
+
+    t0 = ms_now();
+    llist_sort(dl, 6, ids_compare_genid);
+    t1 = ms_now();
+    ullist_sort(ul, 6, ids_compare_genid);
+    t2 = ms_now();
+    report("unrolled", "sort_gen_ms", "llist", t1 - t0, "ms");
+    report("unrolled", "sort_gen_ms", "ullist", t2 - t1, "ms");
+
+    /* after sorting, list order no longer follows allocation order */
+    t0 = ms_now();
+    for (int w = 0; w < walks; w++) s1 += walk_llist(dl);
+    t1 = ms_now();
+    for (int w = 0; w < walks; w++) s2 += walk_ullist(ul);
+    t2 = ms_now();
+    report("unrolled", "sorted_walk_ns_per_elem", "llist", (t1 - t0) * 1e6 / ((double)walks * n), "ns");
+    report("unrolled", "sorted_walk_ns_per_elem", "ullist", (t2 - t1) * 1e6 / ((double)walks * n), "ns");
+
+    llist_elem_t *r = dl->ll_front;
+    for (ullist_block_t *b = ul->ul_front; b; b = b->ul_next) {
+        for (int i = 0; i < b->ul_count; i++, r = r->ll_next) {
+            if (r->data_ptr != b->ul_data[i]) {
+                fprintf(stderr, "bench: sorted order differs\n");
+                exit(1);
+            }
+        }
+    }
+
+    /* the llist owns the records; empty the ullist without freeing them */
+    while (ullist_entries(ul) > 0) ullist_remove(ul, LLPOSITION_BACK);
+    ullist_destruct(ul);
+    llist_destruct(dl);
+    free(pos);
+    free(recs);
+    return 0;
+}
+
+/* ===== columnar store vs pointer list ===== */
+
+static int bench_columnar(int n, long seed)
+{
+    const int scans = 10;
+    alert_t **recs = make_records(n, seed);
+
+    size_t h0 = heap_in_use();
+    llist_t *dl = llist_construct(NULL);
+    for (int i = 0; i < n; i++) llist_insert(dl, recs[i], LLPOSITION_BACK);
+    size_t h1 = heap_in_use();
+    colstore_t *cs = colstore_from_llist(dl);
+    size_t h2 = heap_in_use();
+
+    /* records are 32 bytes each and belong to the pointer list */
+    report("columnar", "bytes_per_elem", "llist", (double)(h1 - h0) / n + sizeof(alert_t), "B");
+    report("columnar", "bytes_per_elem", "colstore", (double)(h2 - h1) / n, "B");
+
+    long s1 = 0, s2 = 0;
+    double t0 = ms_now();
+    for (int w = 0; w < scans; w++)
+        for (llist_elem_t *r = dl->ll_front; r; r = r->ll_next) s1 += r->data_ptr->dest_ip_addr;
+    double t1 = ms_now();
+    for (int w = 0; w < scans; w++)
+        for (int i = 0; i < n; i++) s2 += colstore_get_field(cs, i, COL_DEST_IP_ADDR);
+    double t2 = ms_now();
+    if (s1 != s2) { fprintf(stderr, "bench: scan mismatch\n"); exit(1); }
+    report("columnar", "scan_ns_per_elem", "llist", (t1 - t0) * 1e6 / ((double)scans * n), "ns");
+    report("columnar", "scan_ns_per_elem", "colstore", (t2 - t1) * 1e6 / ((double)scans * n), "ns");
+
+    /* sort gen then ip, as an analyst flipping views would */
+    t0 = ms_now();
+    llist_sort(dl, 5, ids_compare_genid);
+    t1 = ms_now();
+    llist_sort(dl, 6, ids_compare_destip);
+    t2 = ms_now();
+    llist_sort(dl, 6, ids_compare_genid);
+    double t3 = ms_now();
+    report("columnar", "sort_gen_ms", "llist_qsort", t1 - t0, "ms");
+    report("columnar", "sort_ip_ms", "llist_merge6", t2 - t1, "ms");
+    report("columnar", "sort_gen_ms", "llist_merge6", t3 - t2, "ms");
+
+    t0 = ms_now();
+    colstore_sort(cs, COL_DEST_IP_ADDR, 1);
+    t1 = ms_now();
+    colstore_sort(cs, COL_GENERATOR_ID, 0);
+    t2 = ms_now();
+    report("columnar", "sort_ip_ms", "colstore", t1 - t0, "ms");
+    report("columnar", "sort_gen_ms", "colstore", t2 - t1, "ms");
+
+    /* both sorts are stable, so the final orders must agree exactly */
+    int i = 0;
+    for (llist_elem_t *r = dl->ll_front; r; r = r->ll_next, i++) {
+        if (r->data_ptr->generator_id != colstore_get_field(cs, i, COL_GENERATOR_ID) ||
+            r->data_ptr->dest_ip_addr != colstore_get_field(cs, i, COL_DEST_IP_ADDR)) {
+            fprintf(stderr, "bench: columnar order differs at %d\n", i);
+            exit(1);
+        }
+    }
+
+    colstore_destruct(cs);
+    llist_destruct(dl);
+    free(recs);
+    return 0;
+}
+
+/* ===== index-linked arena vs pointer list ===== */
+
+static int bench_indexed(int n, long seed)
+{
+    static const int types[] = { 4, 5 };
+    const int walks = 10;
+    alert_t **recs = make_records(n, seed);
+
+    size_t h0 = heap_in_use();
+    llist_t *dl = llist_construct(NULL);
+    for (int i = 0; i < n; i++) llist_insert(dl, recs[i], LLPOSITION_BACK);
+    size_t h1 = heap_in_use();
+    ilist_t *il = ilist_construct(NULL);
+    for (int i = 0; i < n; i++) {
+        alert_t *copy = (alert_t *) malloc(sizeof(alert_t));
+        *copy = *recs[i];
+        ilist_insert(il, copy, LLPOSITION_BACK);
+    }
+    size_t h2 = heap_in_use();
+
+    /* llist records were allocated by make_records; ilist holds them inline */
+    report("indexed", "bytes_per_elem", "llist", (double)(h1 - h0) / n + sizeof(alert_t), "B");
+    report("indexed", "bytes_per_elem", "ilist", (double)(h2 - h1) / n, "B");
+    report("indexed", "bytes_per_elem", "ilist_live", (double)sizeof(ilist_node_t), "B");
+
+    long s1 = 0, s2 = 0;
+    double t0 = ms_now();
+    for (int w = 0; w < walks; w++) s1 += walk_llist(dl);
+    double t1 = ms_now();
+    for (int w = 0; w < walks; w++)
+        for (uint32_t r = il->il_front; r != ILIST_NIL; r = il->il_nodes[r].il_next)
+            s2 += il->il_nodes[r].il_data.generator_id;
+    double t2 = ms_now();
+    if (s1 != s2) { fprintf(stderr, "bench: walk mismatch\n"); exit(1); }
+    report("indexed", "walk_ns_per_elem", "llist", (t1 - t0) * 1e6 / ((double)walks * n), "ns");
+    report("indexed", "walk_ns_per_elem", "ilist", (t2 - t1) * 1e6 / ((double)walks * n), "ns");
+
+    for (int t = 0; t < 2; t++) {
+        char metric[32];
+        snprintf(metric, sizeof(metric), "sort%d_gen_ms", types[t]);
+        t0 = ms_now();
+        llist_sort(dl, types[t], ids_compare_genid);
+        t1 = ms_now();
+        ilist_sort(il, types[t], ids_compare_genid);
+        t2 = ms_now();
+        report("indexed", metric, "llist", t1 - t0, "ms");
+        report("indexed", metric, "ilist", t2 - t1, "ms");
+
+        /* neither type is stable on llist, so only the keys must agree */
+        llist_elem_t *r = dl->ll_front;
+        for (uint32_t i = il->il_front; i != ILIST_NIL; i = il->il_nodes[i].il_next, r = r->ll_next) {
+            if (r->data_ptr->generator_id != il->il_nodes[i].il_data.generator_id) {
+                fprintf(stderr, "bench: indexed order differs\n");
+                exit(1);
+            }
+        }
+        /* shuffle back to a fresh order for the next type */
+        llist_sort(dl, 6, ids_compare_destip);
+        ilist_sort(il, 4, ids_compare_destip);
+    }
+
+    ilist_destruct(il);
+    llist_destruct(dl);
+    free(recs);
+    return 0;
+}
+
+/* ===== physical compaction after a sort ===== */
+
+static int bench_compact(int n, long seed)
+{
+    static const int modes[] = { LLCOMPACT_OFF, LLCOMPACT_NODES, LLCOMPACT_RECORDS };
+    static const char *names[] = { "scattered", "nodes", "records" };
+    const int walks = 10;
+    alert_t **recs = make_records(n, seed);
+    llist_t *dl = llist_construct(NULL);
+    for (int i = 0; i < n; i++) llist_insert(dl, recs[i], LLPOSITION_BACK);
+    free(recs);
+
+    long check = -1;
+    for (int m = 0; m < 3; m++) {
+        /* an ip sort leaves list order unrelated to memory order */
+        llist_sort(dl, 6, ids_compare_destip);
+        double t0 = ms_now();
+        if (modes[m] != LLCOMPACT_OFF) llist_compact(dl, modes[m]);
+        double t1 = ms_now();
+        if (modes[m] != LLCOMPACT_OFF) report("compact", "compact_ms", names[m], t1 - t0, "ms");
+
+        long sum = 0;
+        t0 = ms_now();
+        for (int w = 0; w < walks; w++) sum += walk_llist(dl);
+        t1 = ms_now();
+        if (check >= 0 && sum != check) { fprintf(stderr, "bench: walk mismatch\n"); exit(1); }
+        check = sum;
+        report("compact", "walk_ns_per_elem", names[m], (t1 - t0) * 1e6 / ((double)walks * n), "ns");
+
+        t0 = ms_now();
+        llist_sort(dl, 4, ids_compare_genid);
+        t1 = ms_now();
+        report("compact", "resort4_gen_ms", names[m], t1 - t0, "ms");
+        llist_sort(dl, 6, ids_compare_destip);
+        if (modes[m] != LLCOMPACT_OFF) llist_compact(dl, modes[m]);
+        t0 = ms_now();
+        llist_sort(dl, 6, ids_compare_genid);
+        t1 = ms_now();
+        report("compact", "resort6_gen_ms", names[m], t1 - t0, "ms");
+    }
+
+    llist_destruct(dl);
+    return 0;
+}
+
+/* ===== dual-order lists ===== */
+
+static int bench_dual(int n, long seed)
+{
+    static const char *names[] = { "plain", "dual" };
+    const int switches = 5;
+    alert_t **recs = make_records(n, seed);
+
+    for (int d = 0; d < 2; d++) {
+        size_t h0 = heap_in_use();
+        llist_t *L = llist_construct(NULL);
+        llist_set_dual(L, d);
+        for (int i = 0; i < n; i++) {
+            alert_t *r = (alert_t *) malloc(sizeof(alert_t));
+            *r = *recs[i];
+            llist_insert(L, r, LLPOSITION_BACK);
+        }
+        size_t h1 = heap_in_use();
+        report("dual", "bytes_per_elem", names[d], (double)(h1 - h0) / n, "B");
+
+        double t0 = ms_now();
+        ids_sort_gen(L, 6);
+        double t1 = ms_now();
+        ids_sort_ip(L, 6);
+        double t2 = ms_now();
+        report("dual", "first_gen_ms", names[d], t1 - t0, "ms");
+        report("dual", "first_ip_ms", names[d], t2 - t1, "ms");
+
+        /* alternate fields with nothing appended in between */
+        double gen_ms = 0, ip_ms = 0;
+        for (int s = 0; s < switches; s++) {
+            t0 = ms_now();
+            ids_sort_gen(L, 6);
+            t1 = ms_now();
+            ids_sort_ip(L, 6);
+            t2 = ms_now();
+            gen_ms += t1 - t0;
+            ip_ms += t2 - t1;
+        }
+        report("dual", "switch_gen_ms", names[d], gen_ms / switches, "ms");
+        report("dual", "switch_ip_ms", names[d], ip_ms / switches, "ms");
+
+        /* one append makes the kept order stale: a near-sorted re-sort */
+        alert_t *r = (alert_t *) malloc(sizeof(alert_t));
+        *r = *recs[0];
+        llist_insert(L, r, LLPOSITION_BACK);
+        t0 = ms_now();
+        ids_sort_gen(L, 6);
+        t1 = ms_now();
+        report("dual", "after_append_gen_ms", names[d], t1 - t0, "ms");
+        llist_destruct(L);
+    }
+    for (int i = 0; i < n; i++) free(recs[i]);
+    free(recs);
+    return 0;
+}
+
+/* ===== multi-producer ingest ===== */
+
+struct ingest_arg {
+    ingest_queue_t *q;
+    int id;
+    int count;
+};
+
+/* records carry (producer, sequence) so the consumer can check ordering */
+static void *ingest_producer_main(void *argp)
+{
+    struct ingest_arg *arg = (struct ingest_arg *) argp;
+    ingest_producer_t p;
+    ingest_producer_init(&p, arg->q);
+    for (int i = 0; i < arg->count; i++) {
+        alert_t *rec = (alert_t *) calloc(1, sizeof(alert_t));
+        rec->generator_id = arg->id;
+        rec->dest_ip_addr = i;
+        ingest_append(&p, rec);
+    }
+    ingest_flush(&p);
+    return NULL;
+}
+
+static int bench_ingest(int n, long seed)
+{
+    static const int threads[] = { 1, 2, 4, 8, 16 };
+    (void) seed;
+
+    /* single-threaded llist_insert with no queue, for reference */
+    llist_t *L = llist_construct(NULL);
+    double t0 = ms_now();
+    for (int i = 0; i < n; i++) ids_append_rear_fast(L, 0, i);
+    double t1 = ms_now();
+    report("ingest", "appends_per_sec", "direct", n / ((t1 - t0) / 1000.0), "/s");
+    llist_destruct(L);
+
+    for (int t = 0; t < 5; t++) {
+        int nt = threads[t];
+        ingest_queue_t *q = ingest_construct();
+        pthread_t tid[16];
+        struct ingest_arg args[16];
+        int *next_seq = (int *) calloc(nt, sizeof(int));
+        L = llist_construct(NULL);
+
+        t0 = ms_now();
+        for (int i = 0; i < nt; i++) {
+            args[i].q = q;
+            args[i].id = i;
+            args[i].count = n / nt + (i < n % nt);
+            pthread_create(&tid[i], NULL, ingest_producer_main, &args[i]);
+        }
+        /* this thread is the consumer, draining while producers run */
+        int drained = 0;
+        while (drained < n) {
+            int k = ingest_drain(q, L);
+            if (k == 0) sched_yield();
+            drained += k;
+        }
+        t1 = ms_now();
+        for (int i = 0; i < nt; i++) pthread_join(tid[i], NULL);
+
+        for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) {
+            if (r->data_ptr->dest_ip_addr != next_seq[r->data_ptr->generator_id]++) {
+                fprintf(stderr, "bench: producer %d out of order\n", r->data_ptr->generator_id);
+                exit(1);
+            }
+        }
+        char name[24];
+        snprintf(name, sizeof(name), "threads%d", nt);
+        report("ingest", "appends_per_sec", name, n / ((t1 - t0) / 1000.0), "/s");
+
+        llist_destruct(L);
+        ingest_destruct(q);
+        free(next_seq);
+    }
+    return 0;
+}
+
+/* ===== snapshot load vs text replay ===== */
+
+static int bench_persist(int n, long seed)
+{
+    const char *path = "bench_persist.snap";
+    alert_t **recs = make_records(n, seed);
+    ids_register_compare();
+
+    /* the APPENDREAR text a restart would otherwise replay */
+    char *text = (char *) malloc((size_t) n * 40);
+    size_t used = 0;
+    for (int i = 0; i < n; i++)
+        used += sprintf(text + used, "APPENDREAR %d %d\n", recs[i]->generator_id, recs[i]->dest_ip_addr);
+
+    double t0 = ms_now();
+    llist_t *L = llist_construct(NULL);
+    for (char *p = text; p < text + used; ) {
+        /* one line at a time, as lab3 reads it (sscanf would strlen the rest) */
+        char line[64];
+        char *nl = strchr(p, '\n');
+        size_t len = nl - p;
+        memcpy(line, p, len);
+        line[len] = '\0';
+        p = nl + 1;
+        int gen, ip;
+        if (sscanf(line, "%*s %d %d", &gen, &ip) == 2) ids_append_rear_fast(L, gen, ip);
+    }
+    double t1 = ms_now();
+    report("persist", "restore_ms", "text_replay", t1 - t0, "ms");
+    ids_sort_ip(L, 6);
+
+    t0 = ms_now();
+    if (llist_save(L, path) != 0) { fprintf(stderr, "bench: cannot write %s\n", path); exit(1); }
+    t1 = ms_now();
+    report("persist", "save_ms", "snapshot", t1 - t0, "ms");
+
+    t0 = ms_now();
+    llist_t *M = llist_load(path);
+    t1 = ms_now();
+    report("persist", "restore_ms", "snapshot", t1 - t0, "ms");
+
+    llist_elem_t *a = L->ll_front, *b = M->ll_front;
+    for (; a && b; a = a->ll_next, b = b->ll_next) {
+        if (a->data_ptr->generator_id != b->data_ptr->generator_id ||
+            a->data_ptr->dest_ip_addr != b->data_ptr->dest_ip_addr) break;
+    }
+    if (a || b || M->compare_fun != ids_compare_destip) {
+        fprintf(stderr, "bench: snapshot differs\n");
+        exit(1);
+    }
+
+    unlink(path);
+    llist_destruct(M);
+    llist_destruct(L);
+    for (int i = 0; i < n; i++) free(recs[i]);
+    free(recs);
+    free(text);
+    return 0;
+}
+
+/* ===== n log n sort types on one shared input ===== */
+
+static int bench_sorts(int n, long seed)
+{
+    static const int types[] = { 4, 5, 6, 7, 8 };
+    alert_t **recs = make_records(n, seed);
+    llist_t *L = llist_construct(NULL);
+    int ntypes = sizeof(types) / sizeof(types[0]);
+
+    fprintf(stderr, "bench: simd kernels %s\n", simdsort_isa());
+    for (int f = 0; f < 2; f++) {
+        for (int t = 0; t < ntypes; t++) {
+            /* restore the original order so every type sees the same input */
+            while (llist_entries(L) > 0) llist_remove(L, LLPOSITION_FRONT);
+            for (int i = 0; i < n; i++) llist_insert(L, recs[i], LLPOSITION_BACK);
+
+            char name[16];
+            snprintf(name, sizeof(name), "type%d", types[t]);
+            double t0 = ms_now();
+            if (f == 0) ids_sort_gen(L, types[t]);
+            else        ids_sort_ip(L, types[t]);
+            double t1 = ms_now();
+            report("sorts", f == 0 ? "sort_gen_ms" : "sort_ip_ms", name, t1 - t0, "ms");
+        }
+    }
+    llist_destruct(L);
+    free(recs);
+    return 0;
+}
+
+/* ===== sort types across key distributions ===== */
+
+/* lists are filled by workload_generate directly, the same keys geninput
+ * would print, so neither the pipe nor the parser is in the numbers
+ */
+static int bench_workload(int n, long seed)
+{
+    static const int types[] = { 4, 5, 6, 7, 8 };
+    int ntypes = sizeof(types) / sizeof(types[0]);
+    int first = bench_dist ? bench_dist : 1, last = bench_dist ? bench_dist : WORKLOAD_NTYPES;
+
+    for (int dist = first; dist <= last; dist++) {
+        for (int f = 0; f < 2; f++) {
+            for (int t = 0; t < ntypes; t++) {
+                llist_t *L = llist_construct(NULL);
+                double t0 = ms_now();
+                workload_generate(dist, n, f == 1, 0.0, seed, append_record, L);
+                double t1 = ms_now();
+                if (f == 0) ids_sort_gen(L, types[t]);
+                else        ids_sort_ip(L, types[t]);
+                double t2 = ms_now();
+
+                char name[32];
+                if (f == 0 && t == 0) {
+                    snprintf(name, sizeof(name), "%s", workload_name(dist));
+                    report("workload", "fill_ns_per_rec", name, (t1 - t0) * 1.0e6 / n, "ns");
+                }
+                snprintf(name, sizeof(name), "%s_type%d", workload_name(dist), types[t]);
+                report("workload", f == 0 ? "sort_gen_ms" : "sort_ip_ms", name, t2 - t1, "ms");
+                llist_destruct(L);
+            }
+        }
+    }
+    return 0;
+}
+
+/* ===== k-way merge: loser tree vs pairwise rounds ===== */
+
+static long kmerge_compares;
+
+static int kmerge_compare(const data_t *a, const data_t *b)
+{
+    kmerge_compares++;
+    return ids_compare_genid(a, b);
+}
+
+/* k sorted runs, each a contiguous slice of recs */
+static llist_t **kmerge_runs(alert_t **recs, int n, int k)
+{
+    llist_t **runs = (llist_t **) malloc(k * sizeof(llist_t *));
+    for (int j = 0; j < k; j++) {
+        runs[j] = llist_construct(NULL);
+        for (int i = (long) n * j / k; i < (long) n * (j + 1) / k; i++)
+            llist_insert(runs[j], recs[i], LLPOSITION_BACK);
+        llist_sort(runs[j], 6, kmerge_compare);
+    }
+    return runs;
+}
+
+/* empty L without freeing the shared records */
+static void kmerge_release(llist_t *L)
+{
+    while (llist_entries(L) > 0) llist_remove(L, LLPOSITION_FRONT);
+    llist_destruct(L);
+}
+
+static int bench_kmerge(int n, long seed)
+{
+    static const int ks[] = { 2, 4, 16, 64, 256 };
+    alert_t **recs = make_records(n, seed);
+    data_t **order = (data_t **) malloc(n * sizeof(data_t *));
+    int nks = sizeof(ks) / sizeof(ks[0]);
+
+    for (int t = 0; t < nks; t++) {
+        int k = ks[t];
+        char name[24];
+
+        llist_t **runs = kmerge_runs(recs, n, k);
+        llist_t *L = llist_construct(NULL);
+        kmerge_compares = 0;
+        double t0 = ms_now();
+        llist_merge_sorted(L, runs, k, kmerge_compare);
+        double t1 = ms_now();
+        snprintf(name, sizeof(name), "losertree_k%d", k);
+        report("kmerge", "merge_ms", name, t1 - t0, "ms");
+        report("kmerge", "compares_per_elem", name, (double) kmerge_compares / n, "cmp");
+        int i = 0;
+        for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) order[i++] = r->data_ptr;
+        kmerge_release(L);
+        for (int j = 0; j < k; j++) kmerge_release(runs[j]);
+        free(runs);
+
+        /* the pipeline's schedule: merge neighbours until one run is left */
+        runs = kmerge_runs(recs, n, k);
+        kmerge_compares = 0;
+        t0 = ms_now();
+        for (int m = k; m > 1; m = (m + 1) / 2) {
+            for (int j = 0; j < m / 2; j++) {
+                llist_merge(runs[2 * j], runs[2 * j + 1]);
+                kmerge_release(runs[2 * j + 1]);
+                runs[j] = runs[2 * j];
+            }
+            if (m % 2) runs[m / 2] = runs[m - 1];
+        }
+        t1 = ms_now();
+        snprintf(name, sizeof(name), "pairwise_k%d", k);
+        report("kmerge", "merge_ms", name, t1 - t0, "ms");
+        report("kmerge", "compares_per_elem", name, (double) kmerge_compares / n, "cmp");
+        i = 0;
+        for (llist_elem_t *r = runs[0]->ll_front; r; r = r->ll_next) {
+            if (r->data_ptr != order[i++]) {
+                fprintf(stderr, "bench: loser tree order differs at k=%d\n", k);
+                exit(1);
+            }
+        }
+        kmerge_release(runs[0]);
+        free(runs);
+    }
+    for (int i = 0; i < n; i++) free(recs[i]);
+    free(recs);
+    free(order);
+    return 0;
+}
+
+/* ===== windowed retention vs scanning for old alerts ===== */
+
+static int bench_retain(int n, long seed)
+{
+    const int rate = 1000;      /* alerts per second of feed time */
+    const int window = 60;
+    alert_t **recs = make_records(n, seed);
+
+    for (int use_ring = 1; use_ring >= 0; use_ring--) {
+        llist_t *L = llist_construct(NULL);
+        retain_t *r = use_ring ? retain_construct(window, 1) : NULL;
+        double expire_ms = 0.0;
+        long expired = 0;
+        int peak = 0;
+        for (int i = 0; i < n; i++) {
+            int now = i / rate;
+            ids_append_rear_ts(L, recs[i]->generator_id, recs[i]->dest_ip_addr, now);
+            if (r) retain_track(r, L->ll_back);
+            if ((i + 1) % rate != 0) continue;
+
+            /* once per feed second */
+            if (llist_entries(L) > peak) peak = llist_entries(L);
+            double t0 = ms_now();
+            if (r) {
+                expired += retain_expire(r, L, now);
+            } else {
+                llist_elem_t *e = L->ll_front;
+                while (e) {
+                    llist_elem_t *next = e->ll_next;
+                    if (retain_is_expired(e->data_ptr->timestamp, now, window, 1)) {
+                        free(llist_remove_elem(L, e));
+                        expired++;
+                    }
+                    e = next;
+                }
+            }
+            expire_ms += ms_now() - t0;
+        }
+        const char *name = r ? "buckets" : "scan";
+        report("retain", "expire_ms", name, expire_ms, "ms");
+        report("retain", "expired", name, expired, "alerts");
+        report("retain", "peak_entries", name, peak, "alerts");
+        if (r) retain_destruct(r);
+        llist_destruct(L);
+    }
+    for (int i = 0; i < n; i++) free(recs[i]);
+    free(recs);
+    return 0;
+}
+
+/* ===== heap-backed priority queue vs linked sorted insert ===== */
+
+static int bench_pq(int n, long seed)
+{
+    static const int sizes[] = { 1000, 10000, 30000, 0 };   /* 0 = N */
+    const int linked_max = 30000;    /* O(n^2) past this */
+    alert_t **recs = make_records(n, seed);
+    data_t **order = (data_t **) malloc(n * sizeof(data_t *));
+    int nsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    for (int t = 0; t < nsizes; t++) {
+        int m = (sizes[t] == 0 || sizes[t] > n) ? n : sizes[t];
+        if (t > 0 && m <= sizes[t - 1]) break;
+        for (int heap = 1; heap >= 0; heap--) {
+            if (!heap && m > linked_max) continue;
+            llist_t *L = heap ? llist_construct_heap(ids_compare_genid) : llist_construct(ids_compare_genid);
+            char name[24];
+            snprintf(name, sizeof(name), "%s_n%d", heap ? "heap" : "linked", m);
+
+            double t0 = ms_now();
+            for (int i = 0; i < m; i++) llist_insert_sorted(L, recs[i]);
+            double t1 = ms_now();
+            for (int i = 0; i < m; i++) {
+                data_t *d = llist_remove(L, LLPOSITION_FRONT);
+                if (heap) order[i] = d;
+                else if (d != order[i]) {
+                    fprintf(stderr, "bench: heap order differs at %d of %d\n", i, m);
+                    exit(1);
+                }
+            }
+            double t2 = ms_now();
+            report("pq", "insert_ns_per_op", name, (t1 - t0) * 1.0e6 / m, "ns");
+            report("pq", "remove_front_ns_per_op", name, (t2 - t1) * 1.0e6 / m, "ns");
+            llist_destruct(L);
+        }
+    }
+    for (int i = 0; i < n; i++) free(recs[i]);
+    free(recs);
+    free(order);
+    return 0;
+}
+
+/* ===== per-call latency of the core llist operations ===== */
+
+enum { POS_FRONT, POS_BACK, POS_MIDDLE, POS_RANDOM, POS_COUNT };
+static const char *pos_names[POS_COUNT] = { "front", "back", "middle", "random" };
+
+static int adt_index(int pos, int count)
+{
+    switch (pos) {
+    case POS_FRONT:  return 0;
+    case POS_BACK:   return count - 1;
+    case POS_MIDDLE: return count / 2;
+    default:         return (int) (drand48() * count);
+    }
+}
+
+/* llist_elem_find match on identity, so the position found is exact */
+static int adt_same(const data_t *a, const data_t *b)
+{
+    return a == b ? 0 : 1;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* sorts ns[] and prints p50/p90/p99/max rows for one op and cell */
+static void adt_report(const char *op, const char *cell, double *ns, int k)
+{
+    static const struct { const char *name; double q; } stats[] = {
+        { "p50", 0.50 }, { "p90", 0.90 }, { "p99", 0.99 }, { "max", 1.0 },
+    };
+    char metric[48];
+    qsort(ns, k, sizeof(double), compare_double);
+    for (int i = 0; i < 4; i++) {
+        int at = (int) (stats[i].q * (k - 1) + 0.5);
+        snprintf(metric, sizeof(metric), "%s_%s_ns", op, stats[i].name);
+        report("adt", metric, cell, ns[at], "ns");
+    }
+}
+
+/* Each call is timed on its own, and an untimed call undoes it so the
+ * list stays at size m (an insert is followed by a remove of the same
+ * node, a remove by putting it back).  Sorted insert picks its key by
+ * position: below every key, above every key, the median key, or the
+ * key of a random record.
+ */
+static int bench_adt(int n, long seed)
+{
+    static const int sizes[] = { 1000, 10000, 100000, 0 };   /* 0 = N */
+    alert_t **recs = make_records(n, seed);
+    alert_t probe;
+    double *ns = (double *) malloc(2000 * sizeof(double));
+    int nsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    /* clock_gettime's own cost is inside every sample below */
+    for (int i = 0; i < 2000; i++) {
+        double t0 = ms_now();
+        ns[i] = (ms_now() - t0) * 1.0e6;
+    }
+    qsort(ns, 2000, sizeof(double), compare_double);
+    report("adt", "timer_overhead_ns", "clock_gettime", ns[1000], "ns");
+
+    memset(&probe, 0, sizeof(probe));
+    srand48(seed);
+    for (int t = 0; t < nsizes; t++) {
+        int m = (sizes[t] == 0 || sizes[t] > n) ? n : sizes[t];
+        if (t > 0 && m <= sizes[t - 1]) break;
+        /* samples per cell, fewer where the walks are long */
+        int k = 20000000 / m;
+        k = k > 2000 ? 2000 : (k < 50 ? 50 : k);
+
+        llist_t *L = llist_construct(NULL);
+        for (int i = 0; i < m; i++) llist_insert(L, recs[i], LLPOSITION_BACK);
+        llist_t *S = llist_construct(ids_compare_genid);
+        for (int i = 0; i < m; i++) llist_insert(S, recs[i], LLPOSITION_BACK);
+        ids_sort_gen(S, 6);
+
+        for (int pos = 0; pos < POS_COUNT; pos++) {
+            char cell[32];
+            snprintf(cell, sizeof(cell), "%s_n%d", pos_names[pos], m);
+
+            for (int i = 0; i < k; i++) {
+                int at = adt_index(pos, m + 1);
+                double t0 = ms_now();
+                llist_insert(L, &probe, at);
+                ns[i] = (ms_now() - t0) * 1.0e6;
+                llist_remove(L, at > m ? m : at);
+            }
+            adt_report("insert", cell, ns, k);
+
+            for (int i = 0; i < k; i++) {
+                int at = adt_index(pos, m);
+                double t0 = ms_now();
+                data_t *d = llist_remove(L, at);
+                ns[i] = (ms_now() - t0) * 1.0e6;
+                llist_insert(L, d, at);
+            }
+            adt_report("remove", cell, ns, k);
+
+            for (int i = 0; i < k; i++) {
+                int at = adt_index(pos, m);
+                double t0 = ms_now();
+                data_t *d = llist_access(L, at);
+                ns[i] = (ms_now() - t0) * 1.0e6;
+                if (d == NULL) exit(1);
+            }
+            adt_report("access", cell, ns, k);
+
+            for (int i = 0; i < k; i++) {
+                int at = adt_index(pos, m), found;
+                data_t *want = llist_access(L, at);
+                double t0 = ms_now();
+                llist_elem_find(L, want, &found, adt_same);
+                ns[i] = (ms_now() - t0) * 1.0e6;
+                if (found != at) {
+                    fprintf(stderr, "bench: elem_find at %d returned %d\n", at, found);
+                    exit(1);
+                }
+            }
+            adt_report("elem_find", cell, ns, k);
+
+            for (int i = 0; i < k; i++) {
+                switch (pos) {
+                case POS_FRONT: probe.generator_id = -1; break;
+                case POS_BACK:  probe.generator_id = 0x7fffffff; break;
+                default:
+                    probe.generator_id = llist_access(S, adt_index(pos, m))->generator_id;
+                }
+                int found;
+                double t0 = ms_now();
+                llist_insert_sorted(S, &probe);
+                ns[i] = (ms_now() - t0) * 1.0e6;
+                llist_elem_find(S, &probe, &found, adt_same);
+                llist_remove(S, found);
+            }
+            adt_report("insert_sorted", cell, ns, k);
+        }
+        kmerge_release(S);
+        kmerge_release(L);
+    }
+    for (int i = 0; i < n; i++) free(recs[i]);
+    free(recs);
+    free(ns);
+    return 0;
+}
+
+/* ===== list clones ===== */
+
+static int bench_clone(int n, long seed)
+{
+    const int reps = 5;
+    alert_t **recs = make_records(n, seed);
+    llist_t *L = llist_construct(NULL);
+    for (int i = 0; i < n; i++) llist_insert(L, recs[i], LLPOSITION_BACK);
+    free(recs);
+    ids_sort_ip(L, 6);   /* scatter list order against memory order */
+
+    /* what a clone replaces: one llist_insert per node */
+    double t0 = ms_now();
+    for (int r = 0; r < reps; r++) {
+        llist_t *C = llist_construct(NULL);
+        for (llist_elem_t *e = L->ll_front; e; e = e->ll_next) llist_insert(C, e->data_ptr, LLPOSITION_BACK);
+        kmerge_release(C);
+    }
+    double t1 = ms_now();
+    report("clone", "copy_ms", "llist_insert", (t1 - t0) / reps, "ms");
+
+    for (int deep = 0; deep < 2; deep++) {
+        const char *name = deep ? "deep" : "shallow";
+        double clone_ms = 0, sort_ms = 0;
+        for (int r = 0; r < reps; r++) {
+            t0 = ms_now();
+            llist_t *C = llist_clone(L, deep);
+            t1 = ms_now();
+            ids_sort_gen(C, 6);
+            double t2 = ms_now();
+            clone_ms += t1 - t0;
+            sort_ms += t2 - t1;
+            llist_destruct(C);
+        }
+        report("clone", "copy_ms", name, clone_ms / reps, "ms");
+        report("clone", "sort6_gen_ms", name, sort_ms / reps, "ms");
+    }
+    t0 = ms_now();
+    ids_sort_gen(L, 6);
+    t1 = ms_now();
+    report("clone", "sort6_gen_ms", "original", t1 - t0, "ms");
+
+    llist_destruct(L);
+    return 0;
+}
+
+/* ===== compressed cold tier ===== */
+
+static long scan_cold(coldtier_t *ct)
+{
+    long sum = 0;
+    for (int b = 0; b < ct->ct_nblocks; b++) {
+        int m;
+        const alert_t *recs = coldtier_block(ct, b, &m);
+        for (int i = 0; i < m; i++) sum += recs[i].dest_ip_addr;
+    }
+    return sum;
+}
+
+/* freeze the whole list unsorted and after each sort; the deltas of a
+ * sorted key are what the tier compresses best
+ */
+static int bench_cold(int n, long seed)
+{
+    static const char *names[] = { "unsorted", "gen_sorted", "ip_sorted" };
+    const int scans = 10;
+    const int gets = 100000;
+
+    for (int order = 0; order < 3; order++) {
+        alert_t **recs = make_records(n, seed);
+        size_t h0 = heap_in_use();
+        llist_t *L = llist_construct(NULL);
+        for (int i = 0; i < n; i++) llist_insert(L, recs[i], LLPOSITION_BACK);
+        size_t h1 = heap_in_use();
+        free(recs);
+        if (order == 1) ids_sort_gen(L, 6);
+        if (order == 2) ids_sort_ip(L, 6);
+        const char *name = names[order];
+
+        /* records are calloc'd before h0, so add them to the nodes */
+        double hot = (double) (h1 - h0) / n + sizeof(alert_t);
+        long s1 = 0, s2 = 0;
+        double t0 = ms_now();
+        for (int w = 0; w < scans; w++)
+            for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) s1 += r->data_ptr->dest_ip_addr;
+        double t1 = ms_now();
+        double hot_ms = t1 - t0;
+
+        coldtier_t *ct = coldtier_construct();
+        coldtier_freeze(ct, L, -1);
+        double t2 = ms_now();
+        double cold = (double) coldtier_bytes(ct) / n;
+        report("cold", "bytes_per_elem", name, hot, "B (hot)");
+        report("cold", "bytes_per_elem", name, cold, "B (cold)");
+        report("cold", "ratio", name, hot / cold, "x");
+        report("cold", "freeze_ms", name, t2 - t1, "ms");
+
+        t0 = ms_now();
+        for (int w = 0; w < scans; w++) s2 += scan_cold(ct);
+        double t3 = ms_now();
+        if (s1 != s2) { fprintf(stderr, "bench: cold scan mismatch\n"); exit(1); }
+        report("cold", "scan_Mrec_per_s", name, (double) scans * n / (hot_ms * 1e3), "hot");
+        report("cold", "scan_Mrec_per_s", name, (double) scans * n / ((t3 - t0) * 1e3), "cold");
+
+        srand48(seed);
+        alert_t rec;
+        t0 = ms_now();
+        for (int g = 0; g < gets; g++) coldtier_get(ct, (long) (drand48() * n), &rec);
+        t1 = ms_now();
+        report("cold", "get_ns", name, (t1 - t0) * 1e6 / gets, "ns");
+
+        t0 = ms_now();
+        coldtier_thaw(ct, L);
+        t1 = ms_now();
+        report("cold", "thaw_ms", name, t1 - t0, "ms");
+        s2 = 0;
+        for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) s2 += r->data_ptr->dest_ip_addr;
+        if (llist_entries(L) != n || s2 * scans != s1) { fprintf(stderr, "bench: thaw mismatch\n"); exit(1); }
+
+        coldtier_destruct(ct);
+        llist_destruct(L);
+    }
+    return 0;
+}
+
+/* ===== PRINTQ output paths ===== */
+
+/* the format ids_print_alert_rec produces, three stdio calls per record */
+static void printf_alert(FILE *fp, int index, const alert_t *rec)
+{
+    fprintf(fp, "%d: ", index);
+    fprintf(fp, "[%d:%d:%d] (gen, sig, rev): ", rec->generator_id, rec->signature_id, rec->revision_id);
+    fprintf(fp, "Dest IP: %d, Src: %d, Dest port: %d,", rec->dest_ip_addr, rec->src_ip_addr, rec->dest_port_num);
+    fprintf(fp, " Src: %d, Time: %d\n", rec->src_port_num, rec->timestamp);
+}
+
+static int bench_printq(int n, long seed)
+{
+    alert_t **recs = make_records(n, seed);
+    llist_t *L = llist_construct(NULL);
+    for (int i = 0; i < n; i++) {
+        recs[i]->timestamp = i;
+        llist_insert(L, recs[i], LLPOSITION_BACK);
+    }
+    free(recs);
+    ids_sort_ip(L, 6);
+
+    FILE *fp = fopen("/dev/null", "w");
+    int fd = open("/dev/null", O_WRONLY);
+    if (fp == NULL || fd < 0) { fprintf(stderr, "bench: cannot open /dev/null\n"); exit(1); }
+
+    double t0 = ms_now();
+    int i = 1;
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) printf_alert(fp, i++, r->data_ptr);
+    fflush(fp);
+    double t1 = ms_now();
+    report("printq", "records_per_sec", "printf", n / ((t1 - t0) / 1000.0), "rec/s");
+
+    recout_t *o = recout_open(fd, 0);
+    t0 = ms_now();
+    i = 1;
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) recout_text(o, i++, r->data_ptr);
+    recout_flush(o);
+    t1 = ms_now();
+    report("printq", "records_per_sec", "recout_text", n / ((t1 - t0) / 1000.0), "rec/s");
+
+    t0 = ms_now();
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) recout_binary(o, r->data_ptr);
+    recout_flush(o);
+    t1 = ms_now();
+    report("printq", "records_per_sec", "recout_binary", n / ((t1 - t0) / 1000.0), "rec/s");
+    recout_close(o);
+
+    /* the old ids_print reached record i with llist_access(i): O(n^2) */
+    int m = n < 20000 ? n : 20000;
+    long s1 = 0, s2 = 0;
+    t0 = ms_now();
+    for (int k = 0; k < m; k++) s1 += ((alert_t *) llist_access(L, k))->generator_id;
+    t1 = ms_now();
+    report("printq", "walk_ns_per_rec", "llist_access", (t1 - t0) * 1e6 / m, "ns");
+    t0 = ms_now();
+    i = 0;
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next, i++)
+        if (i < m) s2 += r->data_ptr->generator_id;
+    t1 = ms_now();
+    report("printq", "walk_ns_per_rec", "chain", (t1 - t0) * 1e6 / n, "ns");
+    if (s1 != s2) { fprintf(stderr, "bench: walk mismatch\n"); exit(1); }
+
+    fclose(fp);
+    close(fd);
+    llist_destruct(L);
+    return 0;
+}
+
+/* ===== suite table ===== */
+
+struct suite {
+    const char *name;
+    int (*run)(int n, long seed);
+    const char *help;
+};
+
+static const struct suite suites[] = {
+    { "unrolled", bench_unrolled, "unrolled list vs doubly linked list: memory, walk, access, sort" },
+    { "columnar", bench_columnar, "columnar store vs pointer list: memory, field scan, sort" },
+    { "indexed",  bench_indexed,  "index-linked node arena vs pointer list: memory, walk, sort" },
+    { "clone",    bench_clone,    "llist_clone shallow/deep vs re-inserting, and sorting the copy" },
+    { "compact",  bench_compact,  "walk and re-sort times before and after llist_compact" },
+    { "dual",     bench_dual,     "dual-order list: first sorts, then gen/ip switches vs re-sorting" },
+    { "ingest",   bench_ingest,   "MPSC ingest queue appends/sec at 1-16 producer threads" },
+    { "persist",  bench_persist,  "llist_load of a snapshot vs replaying APPENDREAR text" },
+    { "sorts",    bench_sorts,    "n log n llist sort types on the same input, both fields" },
+    { "workload", bench_workload, "sort types 4-8 on each workload.h distribution, filled in-process" },
+    { "adt",      bench_adt,      "per-call latency percentiles of llist ops by size and position" },
+    { "kmerge",   bench_kmerge,   "loser-tree k-way merge vs pairwise llist_merge rounds" },
+    { "pq",       bench_pq,       "llist_construct_heap vs linked sorted insert, remove front" },
+    { "cold",     bench_cold,     "cold tier: bytes and scan rate vs the hot list, get and thaw cost" },
+    { "printq",   bench_printq,   "PRINTQ records/sec: per-record printf vs recout text and binary" },
+    { "retain",   bench_retain,   "bucketed WINDOW expiry vs scanning the queue, 60 s window" },
+};
+
+int main(int argc, char *argv[])
+{
+    int nsuites = sizeof(suites) / sizeof(suites[0]);
+    if (argc < 2) {
+        printf("Usage: ./bench suite [N] [seed] [dist]\n");
+        for (int i = 0; i < nsuites; i++) printf("\t%-10s %s\n", suites[i].name, suites[i].help);
+        exit(1);
+    }
+    int n = (argc > 2) ? atoi(argv[2]) : DEFAULT_N;
+    long seed = (argc > 3) ? atol(argv[3]) : DEFAULT_SEED;
+    if (n < 2) {
+        printf("bench has invalid number records: %d\n", n);
+        exit(2);
+    }
+    if (argc > 4 && (bench_dist = workload_lookup(argv[4])) < 0) {
+        printf("bench has invalid distribution: %s\n", argv[4]);
+        exit(2);
+    }
+    for (int i = 0; i < nsuites; i++) {
+        if (strcmp(argv[1], suites[i].name) == 0) return suites[i].run(n, seed);
+    }
+    printf("bench has invalid suite: %s\n", argv[1]);
+    exit(2);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -29,26 +29,96 @@ my @alltest = qw(
         t51_qsort
         t52_qsort
         t53_qsort
+        t54_pipe
+        t61_stable
+        t62_stable
+        t63_stable
+        t64_pipe
+        t71_cols
+        t72_cols
+        t81_pdq
+        t82_pdq
+        t83_pdq
+        t14_fewunique
+        t44_sawtooth
+        t84_zipf
         t01insert
         t02recsel
         t03itersel
         t04merge
         t05qsort
+        t06stable
+        t06pipe
+        t07simd
+        t07simd_sse
+        t07simd_scalar
+        t08pdq
+        t09async
+        t09async_cols
+        t09async_pipe
+        t10persist
+        t10persist_cols
+        t10persist_pipe
+        t11extsort
+        t11extsort_ext
+        t11extsort_spill
+        t12window
+        t12window_cols
+        t12window_pipe
+        t13hist
+        t13hist_counts
+        t14mem
+        t15dual
+        t15dual_d
+        t15dual_pipe
+        t16dump
+        t16dump_cols
+        t17benchall
+        t17benchall_d
+        t18cold
+        t18cold_d
+        t18cold_pipe
+        t19ullist
+        t20ilist
+        t21heap
+);
+
+# tests that are checked against another test's answer file
+my %sameas = (
+        t07simd_sse    => 't07simd',
+        t07simd_scalar => 't07simd',
+        t54_pipe       => 't52_qsort',
+        t64_pipe       => 't61_stable',
+        t06pipe        => 't06stable',
+        t09async_cols  => 't09async',
+        t09async_pipe  => 't09async',
+        t10persist_cols => 't10persist',
+        t10persist_pipe => 't10persist',
+        t11extsort_ext  => 't11extsort',
+        t11extsort_spill => 't11extsort',
+        t12window_cols  => 't12window',
+        t12window_pipe  => 't12window',
+        t15dual_d       => 't15dual',
+        t15dual_pipe    => 't15dual',
+        t16dump_cols    => 't16dump',
+        t17benchall_d   => 't17benchall',
+        t18cold_d       => 't18cold',
+        t18cold_pipe    => 't18cold',
 );
 
 my $passcount = 0;
 foreach my $test (@alltest) {
     my $gradefile = 'gradingout_'.$test;
     my $valgrindfile = 'gradingout_val'.$test;
-    my $answerfile = 'out_'.$test;
+    my $answerfile = 'out_'.(exists $sameas{$test} ? $sameas{$test} : $test);
 
     my $found = 0;
     if (-f $gradefile) {
         if (-z $gradefile) {
                 print "$test did not complete\n";
         } else {
-            # deletes first line with time information
-            `sed -e "1d" < $gradefile > tempsed123`;
+            # deletes the "<N>\t<msec>\t<type>" lines with time information
+            `grep -Pv '^\\d+\\t[\\d.]+\\t\\d+\$' < $gradefile > tempsed123`;
             my $info = `diff -w tempsed123 ./tests/$answerfile`;
             if ($? > 0) {
                 print "$test failed\n";
@@ -0,0 +1,258 @@
+/* coldtier.c
+ * ECE 2230 Fall 2025
+ * MP3 — compressed cold tier (lab3 FREEZE / COLD)
+ *
+ * Purpose:
+ *   Block layout, for each field in datatypes.h order:
+ *     mode byte 0: one varint, the value every record has
+ *     mode byte 1: varint of the first value, then count-1 varints of
+ *                  the difference from the previous record
+ *   Values and differences are zigzag-encoded in 64 bits, so a difference
+ *   between any two ints fits in at most five varint bytes.  Blocks are
+ *   encoded into a stack buffer of the worst-case size and then copied
+ *   into an allocation of the exact size.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "coldtier.h"
+#include "colstore.h"   /* enum colstore_field: one column per alert_t field */
+#include "memacct.h"
+
+#define VARINT_MAX  5
+#define BLOCK_MAX   (COL_NFIELDS * (1 + VARINT_MAX * COLDTIER_BLOCK_RECS))
+#define STRIDE      ((int) (sizeof(alert_t) / sizeof(int)))   /* ints between records */
+
+/* ===== private helpers ===== */
+static int *rec_field(alert_t *rec, int f);
+static void encode_block(coldtier_t *ct, alert_t *recs, int count);
+static void decode_block(coldtier_t *ct, int b);
+static unsigned char *put_varint(unsigned char *p, uint64_t v);
+static const unsigned char *get_varint(const unsigned char *p, uint64_t *v);
+static uint64_t zigzag(int64_t v);
+static int64_t unzigzag(uint64_t v);
+
+coldtier_t *coldtier_construct(void)
+{
+    coldtier_t *ct = (coldtier_t *) memacct_calloc(MEMACCT_COLD, 1, sizeof(coldtier_t));
+    assert(ct);
+    ct->ct_cached = -1;
+    ct->ct_cache = (alert_t *) memacct_malloc(MEMACCT_COLD, COLDTIER_BLOCK_RECS * sizeof(alert_t));
+    assert(ct->ct_cache);
+    return ct;
+}
+
+void coldtier_destruct(coldtier_t *ct)
+{
+    assert(ct);
+    for (int b = 0; b < ct->ct_nblocks; b++)
+        memacct_free(MEMACCT_COLD, ct->ct_blocks[b].cb_data, ct->ct_blocks[b].cb_bytes);
+    memacct_free(MEMACCT_COLD, ct->ct_blocks, ct->ct_cap * sizeof(coldtier_block_t));
+    memacct_free(MEMACCT_COLD, ct->ct_cache, COLDTIER_BLOCK_RECS * sizeof(alert_t));
+    memacct_free(MEMACCT_COLD, ct, sizeof(coldtier_t));
+}
+
+long coldtier_entries(const coldtier_t *ct)
+{
+    assert(ct && ct->ct_count >= 0);
+    return ct->ct_count;
+}
+
+size_t coldtier_bytes(const coldtier_t *ct)
+{
+    assert(ct);
+    return ct->ct_bytes + ct->ct_nblocks * sizeof(coldtier_block_t);
+}
+
+long coldtier_freeze(coldtier_t *ct, llist_t *list_ptr, long k)
+{
+    assert(ct && list_ptr);
+    long n = llist_entries(list_ptr);
+    if (k < 0 || k > n) k = n;
+
+    alert_t buf[COLDTIER_BLOCK_RECS];
+    for (long done = 0; done < k; ) {
+        int m = (k - done < COLDTIER_BLOCK_RECS) ? (int) (k - done) : COLDTIER_BLOCK_RECS;
+        for (int i = 0; i < m; i++) {
+            alert_t *rec = llist_remove(list_ptr, LLPOSITION_FRONT);
+            buf[i] = *rec;
+            memacct_free(MEMACCT_RECORD, rec, sizeof(alert_t));
+        }
+        encode_block(ct, buf, m);
+        done += m;
+    }
+    return k;
+}
+
+long coldtier_thaw(coldtier_t *ct, llist_t *list_ptr)
+{
+    assert(ct && list_ptr);
+    long n = ct->ct_count;
+    if (n == 0) return 0;
+
+    llist_t *front = llist_construct(NULL);
+    for (int b = 0; b < ct->ct_nblocks; b++) {
+        int m;
+        const alert_t *recs = coldtier_block(ct, b, &m);
+        for (int i = 0; i < m; i++) {
+            alert_t *rec = (alert_t *) memacct_malloc(MEMACCT_RECORD, sizeof(alert_t));
+            assert(rec);
+            *rec = recs[i];
+            llist_insert(front, rec, LLPOSITION_BACK);
+        }
+        memacct_free(MEMACCT_COLD, ct->ct_blocks[b].cb_data, ct->ct_blocks[b].cb_bytes);
+    }
+    /* list_ptr keeps its header (lab3's pipeline points at the queue) */
+    llist_splice(front, list_ptr);
+    llist_splice(list_ptr, front);
+    llist_destruct(front);
+
+    ct->ct_nblocks = 0;
+    ct->ct_count = 0;
+    ct->ct_bytes = 0;
+    ct->ct_cached = -1;
+    return n;
+}
+
+const alert_t *coldtier_block(coldtier_t *ct, int b, int *count)
+{
+    assert(ct && count && b >= 0 && b < ct->ct_nblocks);
+    if (ct->ct_cached != b) decode_block(ct, b);
+    *count = ct->ct_blocks[b].cb_count;
+    return ct->ct_cache;
+}
+
+void coldtier_get(coldtier_t *ct, long pos_index, alert_t *rec)
+{
+    assert(ct && rec && pos_index >= 0 && pos_index < ct->ct_count);
+    /* last block whose first record is at or before pos_index */
+    int lo = 0, hi = ct->ct_nblocks - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (ct->ct_blocks[mid].cb_first <= pos_index) lo = mid;
+        else hi = mid - 1;
+    }
+    int m;
+    const alert_t *recs = coldtier_block(ct, lo, &m);
+    *rec = recs[pos_index - ct->ct_blocks[lo].cb_first];
+}
+
+/* ===== helpers ===== */
+
+static int *rec_field(alert_t *rec, int f)
+{
+    switch (f) {
+        case COL_GENERATOR_ID:  return &rec->generator_id;
+        case COL_SIGNATURE_ID:  return &rec->signature_id;
+        case COL_REVISION_ID:   return &rec->revision_id;
+        case COL_DEST_IP_ADDR:  return &rec->dest_ip_addr;
+        case COL_SRC_IP_ADDR:   return &rec->src_ip_addr;
+        case COL_DEST_PORT_NUM: return &rec->dest_port_num;
+        case COL_SRC_PORT_NUM:  return &rec->src_port_num;
+        case COL_TIMESTAMP:     return &rec->timestamp;
+        default:                assert(0); return NULL;
+    }
+}
+
+static void encode_block(coldtier_t *ct, alert_t *recs, int count)
+{
+    unsigned char buf[BLOCK_MAX];
+    unsigned char *p = buf;
+    for (int f = 0; f < COL_NFIELDS; f++) {
+        int first = *rec_field(&recs[0], f);
+        int constant = 1;
+        for (int i = 1; i < count && constant; i++) constant = (*rec_field(&recs[i], f) == first);
+        *p++ = constant ? 0 : 1;
+        p = put_varint(p, zigzag(first));
+        if (constant) continue;
+        int64_t prev = first;
+        for (int i = 1; i < count; i++) {
+            int64_t v = *rec_field(&recs[i], f);
+            p = put_varint(p, zigzag(v - prev));
+            prev = v;
+        }
+    }
+
+    if (ct->ct_nblocks == ct->ct_cap) {
+        int cap = ct->ct_cap ? 2 * ct->ct_cap : 16;
+        ct->ct_blocks = (coldtier_block_t *) memacct_realloc(MEMACCT_COLD, ct->ct_blocks,
+                ct->ct_cap * sizeof(coldtier_block_t), cap * sizeof(coldtier_block_t));
+        assert(ct->ct_blocks);
+        ct->ct_cap = cap;
+    }
+    coldtier_block_t *blk = &ct->ct_blocks[ct->ct_nblocks++];
+    blk->cb_bytes = p - buf;
+    blk->cb_data = (unsigned char *) memacct_malloc(MEMACCT_COLD, blk->cb_bytes);
+    assert(blk->cb_data);
+    memcpy(blk->cb_data, buf, blk->cb_bytes);
+    blk->cb_count = count;
+    blk->cb_first = ct->ct_count;
+    ct->ct_count += count;
+    ct->ct_bytes += blk->cb_bytes;
+}
+
+/* column by column, straight into the record cache at each field's offset */
+static void decode_block(coldtier_t *ct, int b)
+{
+    const coldtier_block_t *blk = &ct->ct_blocks[b];
+    const unsigned char *p = blk->cb_data;
+    int count = blk->cb_count;
+    for (int f = 0; f < COL_NFIELDS; f++) {
+        int *dst = rec_field(&ct->ct_cache[0], f);
+        int mode = *p++;
+        uint64_t u;
+        p = get_varint(p, &u);
+        int64_t v = unzigzag(u);
+        dst[0] = (int) v;
+        if (mode == 0) {
+            for (int i = 1; i < count; i++) dst[i * STRIDE] = (int) v;
+            continue;
+        }
+        for (int i = 1; i < count; i++) {
+            /* one-byte differences are the common case in a sorted column */
+            if (*p < 0x80) u = *p++;
+            else           p = get_varint(p, &u);
+            v += unzigzag(u);
+            dst[i * STRIDE] = (int) v;
+        }
+    }
+    assert((size_t) (p - blk->cb_data) == blk->cb_bytes);
+    ct->ct_cached = b;
+}
+
+static unsigned char *put_varint(unsigned char *p, uint64_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (unsigned char) (v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char) v;
+    return p;
+}
+
+static const unsigned char *get_varint(const unsigned char *p, uint64_t *v)
+{
+    uint64_t x = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        x |= (uint64_t) (*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    x |= (uint64_t) *p++ << shift;
+    *v = x;
+    return p;
+}
+
+static uint64_t zigzag(int64_t v)
+{
+    return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v)
+{
+    return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,69 @@
+/* coldtier.h
+ * Compressed cold tier for alerts that have aged out of the hot list
+ *
+ * coldtier_freeze moves records off the front of a list into blocks of
+ * up to COLDTIER_BLOCK_RECS records.  Each block stores every alert_t
+ * field as its own column: a constant column is one value, any other is
+ * its first value and then the differences between neighbours, each
+ * zigzag-encoded as a varint.  Frozen after a sort, the sort key costs
+ * about one byte a record and the fields lab3 leaves zero almost
+ * nothing, against sizeof(alert_t) + sizeof(llist_elem_t) hot.
+ *
+ * Records stay in freeze order.  Reads decode one block at a time into a
+ * cache kept in the tier; coldtier_thaw puts every record back in front
+ * of a list when the tier is needed as nodes again.
+ */
+#ifndef COLDTIER_H
+#define COLDTIER_H
+
+#include <stddef.h>
+#include "datatypes.h"
+#include "llist.h"
+
+#define COLDTIER_BLOCK_RECS  256
+
+typedef struct coldtier_block_tag {
+    unsigned char *cb_data;
+    size_t cb_bytes;
+    int cb_count;
+    long cb_first;             /* tier index of the block's first record */
+} coldtier_block_t;
+
+typedef struct coldtier_tag {
+    coldtier_block_t *ct_blocks;
+    int ct_nblocks;
+    int ct_cap;
+    long ct_count;
+    size_t ct_bytes;           /* encoded bytes over all blocks */
+    int ct_cached;             /* block decoded in ct_cache, or -1 */
+    alert_t *ct_cache;         /* COLDTIER_BLOCK_RECS records */
+} coldtier_t;
+
+coldtier_t *    coldtier_construct(void);
+void            coldtier_destruct(coldtier_t *ct);
+long            coldtier_entries(const coldtier_t *ct);
+/* encoded blocks plus the block table; not the decode cache */
+size_t          coldtier_bytes(const coldtier_t *ct);
+
+/* move the first k records of list_ptr (all of them if k < 0 or k is
+ * larger) onto the back of the tier, freeing their records and nodes;
+ * returns how many moved
+ */
+long            coldtier_freeze(coldtier_t *ct, llist_t *list_ptr, long k);
+
+/* move every record back, in order, in front of list_ptr's entries and
+ * empty the tier; list_ptr is left unsorted.  Returns how many moved.
+ */
+long            coldtier_thaw(coldtier_t *ct, llist_t *list_ptr);
+
+/* decode block b (0 .. ct_nblocks-1); the records stay valid until the
+ * next decode from this tier
+ */
+const alert_t * coldtier_block(coldtier_t *ct, int b, int *count);
+
+/* copy record pos_index (0 .. entries-1) into *rec: a binary search over
+ * the blocks, then one block decode unless that block is cached
+ */
+void            coldtier_get(coldtier_t *ct, long pos_index, alert_t *rec);
+
+#endif
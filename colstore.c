@@ -0,0 +1,161 @@
+/* colstore.c
+ * ECE 2230 Fall 2025
+ * MP3 — Columnar alert store
+ *
+ * Purpose:
+ *   Struct-of-arrays container for alert_t.  Rows are appended to every
+ *   column; logical order is the cs_order permutation of row numbers.
+ *
+ * Notes:
+ *   colstore_sort() gathers the sort column into a key array in list
+ *   order, then runs a four-pass LSD radix sort over (key, row) pairs.
+ *   Radix passes are stable, so equal keys keep their list order.  The
+ *   scratch arrays grow with the store and are reused by every sort.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "colstore.h"
+#include "memacct.h"
+
+#define COLSTORE_INIT_CAP 1024
+
+static void colstore_grow(colstore_t *cs);
+static int *rec_field(alert_t *rec, enum colstore_field f);
+
+colstore_t *colstore_construct(void)
+{
+    colstore_t *cs = (colstore_t *) calloc(1, sizeof(colstore_t));
+    assert(cs);
+    return cs;
+}
+
+void colstore_destruct(colstore_t *cs)
+{
+    assert(cs);
+    for (int f = 0; f < COL_NFIELDS; f++) free(cs->cs_col[f]);
+    free(cs->cs_order);
+    free(cs->cs_key_scratch);
+    free(cs->cs_order_scratch);
+    free(cs->cs_key_buf);
+    free(cs);
+}
+
+int colstore_entries(colstore_t *cs)
+{
+    assert(cs && cs->cs_count >= 0);
+    return cs->cs_count;
+}
+
+void colstore_append(colstore_t *cs, const alert_t *rec)
+{
+    assert(cs && rec);
+    if (cs->cs_count == cs->cs_cap) colstore_grow(cs);
+
+    int row = cs->cs_count;
+    alert_t tmp = *rec;
+    for (int f = 0; f < COL_NFIELDS; f++) cs->cs_col[f][row] = *rec_field(&tmp, f);
+    cs->cs_order[row] = (uint32_t) row;
+    cs->cs_count++;
+}
+
+int colstore_get_field(colstore_t *cs, int pos_index, enum colstore_field f)
+{
+    assert(cs && pos_index >= 0 && pos_index < cs->cs_count && f < COL_NFIELDS);
+    return cs->cs_col[f][cs->cs_order[pos_index]];
+}
+
+void colstore_get(colstore_t *cs, int pos_index, alert_t *rec)
+{
+    assert(cs && rec && pos_index >= 0 && pos_index < cs->cs_count);
+    uint32_t row = cs->cs_order[pos_index];
+    for (int f = 0; f < COL_NFIELDS; f++) *rec_field(rec, f) = cs->cs_col[f][row];
+}
+
+void colstore_sort(colstore_t *cs, enum colstore_field f, int descending)
+{
+    assert(cs && f < COL_NFIELDS);
+    int n = cs->cs_count;
+    if (n <= 1) return;
+
+    /* map signed keys to unsigned order; invert for descending */
+    uint32_t flip = descending ? 0x7fffffffu : 0x80000000u;
+    const int *col = cs->cs_col[f];
+    uint32_t *key = cs->cs_key_buf, *key2 = cs->cs_key_scratch;
+    uint32_t *ord = cs->cs_order, *ord2 = cs->cs_order_scratch;
+    for (int i = 0; i < n; i++) key[i] = (uint32_t) col[ord[i]] ^ flip;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        int count[257] = {0};
+        for (int i = 0; i < n; i++) count[((key[i] >> shift) & 0xff) + 1]++;
+        if (count[((key[0] >> shift) & 0xff) + 1] == n) continue;  /* digit all equal */
+        for (int d = 0; d < 256; d++) count[d + 1] += count[d];
+        for (int i = 0; i < n; i++) {
+            int d = (key[i] >> shift) & 0xff;
+            key2[count[d]] = key[i];
+            ord2[count[d]++] = ord[i];
+        }
+        uint32_t *t = key; key = key2; key2 = t;
+        t = ord; ord = ord2; ord2 = t;
+    }
+
+    /* swap buffer ownership to wherever the result landed */
+    cs->cs_key_buf = key;
+    cs->cs_key_scratch = key2;
+    cs->cs_order = ord;
+    cs->cs_order_scratch = ord2;
+}
+
+colstore_t *colstore_from_llist(llist_t *list_ptr)
+{
+    colstore_t *cs = colstore_construct();
+    llist_link(list_ptr);
+    for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next)
+        colstore_append(cs, r->data_ptr);
+    return cs;
+}
+
+void colstore_to_llist(colstore_t *cs, llist_t *list_ptr)
+{
+    for (int i = 0; i < cs->cs_count; i++) {
+        alert_t *rec = (alert_t *) memacct_malloc(MEMACCT_RECORD, sizeof(alert_t));
+        assert(rec);
+        colstore_get(cs, i, rec);
+        llist_insert(list_ptr, rec, LLPOSITION_BACK);
+    }
+}
+
+/* ===== helpers ===== */
+
+static void colstore_grow(colstore_t *cs)
+{
+    int cap = cs->cs_cap ? 2 * cs->cs_cap : COLSTORE_INIT_CAP;
+    for (int f = 0; f < COL_NFIELDS; f++) {
+        cs->cs_col[f] = (int *) realloc(cs->cs_col[f], cap * sizeof(int));
+        assert(cs->cs_col[f]);
+    }
+    cs->cs_order = (uint32_t *) realloc(cs->cs_order, cap * sizeof(uint32_t));
+    cs->cs_order_scratch = (uint32_t *) realloc(cs->cs_order_scratch, cap * sizeof(uint32_t));
+    cs->cs_key_buf = (uint32_t *) realloc(cs->cs_key_buf, cap * sizeof(uint32_t));
+    cs->cs_key_scratch = (uint32_t *) realloc(cs->cs_key_scratch, cap * sizeof(uint32_t));
+    assert(cs->cs_order && cs->cs_order_scratch && cs->cs_key_buf && cs->cs_key_scratch);
+    cs->cs_cap = cap;
+}
+
+static int *rec_field(alert_t *rec, enum colstore_field f)
+{
+    switch (f) {
+        case COL_GENERATOR_ID:  return &rec->generator_id;
+        case COL_SIGNATURE_ID:  return &rec->signature_id;
+        case COL_REVISION_ID:   return &rec->revision_id;
+        case COL_DEST_IP_ADDR:  return &rec->dest_ip_addr;
+        case COL_SRC_IP_ADDR:   return &rec->src_ip_addr;
+        case COL_DEST_PORT_NUM: return &rec->dest_port_num;
+        case COL_SRC_PORT_NUM:  return &rec->src_port_num;
+        case COL_TIMESTAMP:     return &rec->timestamp;
+        default:                assert(0); return NULL;
+    }
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,57 @@
+/* colstore.h
+ * Columnar (struct-of-arrays) alert store
+ *
+ * Each alert_t field lives in its own contiguous int array, indexed by
+ * row.  List order is a separate array of 32-bit row numbers, so sorting
+ * by one field streams only that column and permutes the row numbers.
+ */
+#ifndef COLSTORE_H
+#define COLSTORE_H
+
+#include <stdint.h>
+#include "datatypes.h"
+#include "llist.h"
+
+/* one column per alert_t field, in datatypes.h order */
+enum colstore_field {
+    COL_GENERATOR_ID,
+    COL_SIGNATURE_ID,
+    COL_REVISION_ID,
+    COL_DEST_IP_ADDR,
+    COL_SRC_IP_ADDR,
+    COL_DEST_PORT_NUM,
+    COL_SRC_PORT_NUM,
+    COL_TIMESTAMP,
+    COL_NFIELDS
+};
+
+typedef struct colstore_tag {
+    int *cs_col[COL_NFIELDS];   /* cs_col[f][row] */
+    uint32_t *cs_order;         /* cs_order[pos] = row at list position pos */
+    int cs_count;
+    int cs_cap;
+    uint32_t *cs_key_scratch;   /* sort scratch, kept across sorts */
+    uint32_t *cs_order_scratch;
+    uint32_t *cs_key_buf;
+} colstore_t;
+
+colstore_t *colstore_construct(void);
+void        colstore_destruct(colstore_t *cs);
+int         colstore_entries(colstore_t *cs);
+void        colstore_append(colstore_t *cs, const alert_t *rec);
+int         colstore_get_field(colstore_t *cs, int pos_index, enum colstore_field f);
+void        colstore_get(colstore_t *cs, int pos_index, alert_t *rec);
+
+/* Stable sort of the list order by one column (LSD radix on the key).
+ * descending != 0 puts larger keys first.
+ */
+void        colstore_sort(colstore_t *cs, enum colstore_field f, int descending);
+
+/* Adapters to and from the pointer-based list.  colstore_from_llist
+ * copies records in list order; colstore_to_llist appends freshly
+ * allocated copies to the back of list_ptr.
+ */
+colstore_t *colstore_from_llist(llist_t *list_ptr);
+void        colstore_to_llist(colstore_t *cs, llist_t *list_ptr);
+
+#endif
@@ -0,0 +1,225 @@
+#!/usr/bin/perl
+# complexity.pl — empirical growth fit for the lab3 sorts
+#
+# Sweeps N geometrically for each sort type, list type and field, fits
+# ms = c * N^b by least squares on log(ms) vs log(N) (one point per N, the
+# median over seeds), and compares b and the predicted time at the largest
+# N against a stored baseline.  A change is flagged when it is both
+# statistically significant (z above the threshold, from the fits'
+# standard errors plus a run-to-run noise term) and larger than the
+# minimum effect size.
+#
+# Usage:
+#   ./complexity.pl                              # sweep, compare to the baseline
+#   ./complexity.pl sorts=4,6 fields=gen seeds=1,2,3,4,5   # a subset
+#   ./complexity.pl csv=results/perf.csv         # fit existing rows instead
+#   ./complexity.pl save=results/complexity_baseline.json   # record a baseline
+#
+# Options (key=value):
+#   sorts= listtypes= fields= seeds=   what to sweep (seeds: one run per seed)
+#   min= max= factor=                  N range; default per sort type below
+#   csv=FILE                           fit rows "size,ms,sort_type,field,listtype,seed"
+#   baseline=FILE                      default results/complexity_baseline.json
+#   out=FILE                           JSON report (default stdout)
+#   save=FILE                          also write this run as a baseline
+#   z=3  exp_delta=0.15  slowdown=1.25 significance and effect-size thresholds
+#   noise=0.15                         run-to-run sd of log(ms) between two
+#                                      sweeps (machine load, frequency); the
+#                                      fits' own errors do not see it
+#
+# The report is JSON: one entry per (sort_type, listtype, field) with the
+# points, exponent b and its standard error, constant c (ms at N^b),
+# r^2, a growth class, and the baseline comparison.  A one-line summary
+# per group goes to stderr.  Exit status 1 if anything regressed.
+use strict;
+use warnings;
+use JSON::PP;
+use POSIX qw(floor);
+
+my %opt = (
+    sorts     => '1,2,3,4,5,6,7,8',
+    listtypes => '1,2,3',
+    fields    => 'gen,ip',
+    seeds     => '111,222,333',
+    baseline  => 'results/complexity_baseline.json',
+    z         => 3,
+    exp_delta => 0.15,
+    slowdown  => 1.25,
+    noise     => 0.15,
+);
+foreach my $arg (@ARGV) {
+    if ($arg =~ /^(\w+)=(.*)$/) { $opt{$1} = $2; }
+    else { die "complexity: bad argument '$arg' (want key=value)\n"; }
+}
+
+# quadratic sorts get a smaller range so a sweep stays under a minute
+my %range = (
+    1 => [1000, 16000], 2 => [1000, 8000], 3 => [1000, 16000],
+    4 => [16000, 512000], 5 => [16000, 512000], 6 => [16000, 512000],
+    7 => [16000, 512000], 8 => [16000, 512000],
+);
+
+# ---- collect (N, ms) samples per group ----
+my %samples;    # "sort,listtype,field" => { N => [ms, ...] }
+if ($opt{csv}) {
+    open(my $fh, '<', $opt{csv}) or die "complexity: cannot read $opt{csv}: $!\n";
+    my $header = <$fh>;
+    while (my $line = <$fh>) {
+        chomp $line;
+        my ($n, $ms, $s, $f, $lt) = split /,/, $line;
+        next unless defined $lt && $ms =~ /^[\d.]+$/;
+        push @{ $samples{"$s,$lt,$f"}{$n} }, $ms;
+    }
+    close $fh;
+} else {
+    -x './lab3' or system('make lab3 >&2') == 0 or die "complexity: cannot build lab3\n";
+    -x './geninput' or system('make geninput >&2') == 0 or die "complexity: cannot build geninput\n";
+    foreach my $s (split /,/, $opt{sorts}) {
+        my ($lo, $hi) = @{ $range{$s} // [16000, 512000] };
+        $lo = $opt{min} if $opt{min};
+        $hi = $opt{max} if $opt{max};
+        my $factor = $opt{factor} // 2;
+        foreach my $lt (split /,/, $opt{listtypes}) {
+            foreach my $f (split /,/, $opt{fields}) {
+                for (my $n = $lo; $n <= $hi; $n = floor($n * $factor)) {
+                    foreach my $seed (split /,/, $opt{seeds}) {
+                        my $out = `./geninput $n $lt $s $f $seed | ./lab3`;
+                        my ($ms) = $out =~ /^\d+\t([\d.]+)\t\d+$/m;
+                        die "complexity: no timing line for N=$n type=$s\n" unless defined $ms;
+                        push @{ $samples{"$s,$lt,$f"}{$n} }, $ms;
+                    }
+                }
+            }
+        }
+    }
+}
+
+# ---- fit each group ----
+sub median {
+    my @v = sort { $a <=> $b } @_;
+    return @v % 2 ? $v[$#v / 2] : ($v[@v / 2 - 1] + $v[@v / 2]) / 2;
+}
+
+# least squares of log(ms) on log(N); also the predicted log(ms) at
+# log_x0 and its standard error
+sub fit {
+    my ($pts, $log_x0) = @_;
+    my $k = @$pts;
+    my ($sx, $sy) = (0, 0);
+    foreach my $p (@$pts) { $sx += log($p->[0]); $sy += log($p->[1]); }
+    my ($mx, $my) = ($sx / $k, $sy / $k);
+    my ($sxx, $sxy, $syy) = (0, 0, 0);
+    foreach my $p (@$pts) {
+        my ($dx, $dy) = (log($p->[0]) - $mx, log($p->[1]) - $my);
+        $sxx += $dx * $dx; $sxy += $dx * $dy; $syy += $dy * $dy;
+    }
+    my $b = $sxy / $sxx;
+    my $a = $my - $b * $mx;
+    my $sse = $syy - $b * $sxy;
+    $sse = 0 if $sse < 0;
+    my $s2 = $k > 2 ? $sse / ($k - 2) : 0;
+    return {
+        exponent    => $b,
+        exponent_se => sqrt($s2 / $sxx),
+        constant    => exp($a),
+        r2          => $syy > 0 ? 1 - $sse / $syy : 1,
+        log_pred    => $a + $b * $log_x0,
+        log_pred_se => sqrt($s2 * (1 / $k + ($log_x0 - $mx) ** 2 / $sxx)),
+    };
+}
+
+sub growth_class {
+    my ($b) = @_;
+    return 'n log n or better' if $b < 1.3;
+    return 'superlinear' if $b < 1.7;
+    return 'quadratic' if $b < 2.4;
+    return 'worse than quadratic';
+}
+
+my $baseline = {};
+if (!$opt{save} && -f $opt{baseline}) {
+    open(my $fh, '<', $opt{baseline}) or die "complexity: cannot read $opt{baseline}: $!\n";
+    local $/;
+    my $doc = decode_json(<$fh>);
+    close $fh;
+    $baseline->{"$_->{sort_type},$_->{listtype},$_->{field}"} = $_ foreach @{ $doc->{groups} };
+}
+
+my @groups;
+my $regressions = 0;
+foreach my $key (sort keys %samples) {
+    my ($s, $lt, $f) = split /,/, $key;
+    my @pts = map { [$_, median(@{ $samples{$key}{$_} })] }
+              sort { $a <=> $b } keys %{ $samples{$key} };
+    @pts = grep { $_->[1] > 0 } @pts;
+    if (@pts < 3) {
+        print STDERR "complexity: type $s list $lt $f: fewer than 3 sizes with time > 0, skipped\n";
+        next;
+    }
+    my $nmax = $pts[-1][0];
+    my $r = fit(\@pts, log($nmax));
+    my %g = (
+        sort_type   => $s + 0,
+        listtype    => $lt + 0,
+        field       => $f,
+        points      => [map { { n => $_->[0] + 0, ms => $_->[1] + 0 } } @pts],
+        exponent    => $r->{exponent},
+        exponent_se => $r->{exponent_se},
+        constant    => $r->{constant},
+        r2          => $r->{r2},
+        class       => growth_class($r->{exponent}),
+        n_max       => $nmax + 0,
+        ms_at_n_max => exp($r->{log_pred}),
+        log_pred_se => $r->{log_pred_se},
+        status      => 'no baseline',
+    );
+
+    my $base = $baseline->{$key};
+    if ($base) {
+        # exponent: one-sided z test, and at least exp_delta steeper
+        my $d_exp = $g{exponent} - $base->{exponent};
+        my $se_exp = sqrt($g{exponent_se} ** 2 + $base->{exponent_se} ** 2) || 1e-9;
+        # constant: predicted time at the baseline's largest N
+        my $x0 = log($base->{n_max});
+        my $here = fit(\@pts, $x0);
+        my $d_log = $here->{log_pred} - log($base->{ms_at_n_max});
+        my $se_log = sqrt($here->{log_pred_se} ** 2 + $base->{log_pred_se} ** 2 + $opt{noise} ** 2);
+        my @why;
+        push @why, 'exponent' if $d_exp / $se_exp > $opt{z} && $d_exp > $opt{exp_delta};
+        push @why, 'constant' if $d_log / $se_log > $opt{z} && exp($d_log) > $opt{slowdown};
+        $g{baseline} = {
+            exponent       => $base->{exponent},
+            exponent_delta => $d_exp,
+            exponent_z     => $d_exp / $se_exp,
+            slowdown       => exp($d_log),
+            slowdown_z     => $d_log / $se_log,
+        };
+        $g{status} = @why ? 'regressed: ' . join(', ', @why) : 'ok';
+        $regressions++ if @why;
+    }
+    push @groups, \%g;
+    printf STDERR "type %d list %d %-3s  b=%.3f +/- %.3f  c=%.3g  r2=%.3f  %-18s %s\n",
+        $s, $lt, $f, $g{exponent}, $g{exponent_se}, $g{constant}, $g{r2}, $g{class},
+        $g{baseline} ? sprintf("%s (db=%+.3f, x%.2f)", $g{status}, $g{baseline}{exponent_delta},
+                               $g{baseline}{slowdown})
+                     : $g{status};
+}
+
+my $json = JSON::PP->new->canonical->pretty;
+my $report = { groups => \@groups, regressions => $regressions,
+               thresholds => { z => $opt{z} + 0, exp_delta => $opt{exp_delta} + 0,
+                               slowdown => $opt{slowdown} + 0, noise => $opt{noise} + 0 } };
+if ($opt{out}) {
+    open(my $fh, '>', $opt{out}) or die "complexity: cannot write $opt{out}: $!\n";
+    print $fh $json->encode($report);
+    close $fh;
+} else {
+    print $json->encode($report);
+}
+if ($opt{save}) {
+    open(my $fh, '>', $opt{save}) or die "complexity: cannot write $opt{save}: $!\n";
+    print $fh $json->encode({ groups => \@groups });
+    close $fh;
+    print STDERR "complexity: baseline written to $opt{save}\n";
+}
+exit($regressions ? 1 : 0);
@@ -0,0 +1,450 @@
+/* extsort.c
+ * ECE 2230 Fall 2025
+ * MP3 external merge sort
+ *
+ * Purpose: sort a lab3 command stream whose records do not fit in memory.
+ *          APPENDREAR records are gathered into memory-bounded chunks and
+ *          spilled to unlinked temporary files as packed (generator_id,
+ *          dest_ip_addr, timestamp) triples.  At the sort command each
+ *          chunk is sorted with the list ADT, the sorted runs are merged
+ *          at most -k at a time, and PRINTQ streams the result in lab3's
+ *          format.
+ *
+ * Usage:
+ *     ./extsort [-m budget] [-k fanin] [-T tmpdir] [-s gen|ip] < commands
+ *
+ *     -m  memory budget in bytes, with an optional K, M or G suffix
+ *         (default 64M); covers the resident chunk and the merge buffers
+ *     -k  runs merged per pass (default 16)
+ *     -T  directory for the run files (default $TMPDIR, else .)
+ *     -s  the field the stream will be sorted on.  Chunks are then sorted
+ *         (with type 7) before they spill, which saves reading and
+ *         rewriting every chunk at the sort command.  Chunks sorted on
+ *         the other field are re-sorted correctly, but ties no longer
+ *         come out in input order.
+ *
+ * Input is what geninput produces: APPENDREARs, one SORTGEN t or SORTIP t,
+ * then PRINTQ and QUIT.  Sort type t picks the in-memory engine for the
+ * chunks; with a stable type (6 or 7) the output is the same as lab3's,
+ * since ties between runs go to the earlier run.  APPENDREAR after the
+ * sort and PRINTQ before it are reported on stderr and skipped.  Run and
+ * I/O counts go to stderr.
+ */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "ids_support.h"
+#include "recout.h"
+
+#define MAXLINE 256
+#define DEFAULT_BUDGET  (64L << 20)
+#define DEFAULT_FANIN   16
+/* node + record + two malloc headers + sort scratch for one resident alert */
+#define BYTES_PER_RECORD 112
+#define IO_RECS 1024
+
+/* run order */
+#define ORDER_NONE  0   /* input order */
+#define ORDER_GEN   1
+#define ORDER_IP    2
+
+/* on-disk record: only the fields APPENDREAR carries */
+typedef struct run_rec_tag {
+    int32_t generator_id;
+    int32_t dest_ip_addr;
+    int32_t timestamp;
+} run_rec_t;
+
+typedef struct run_tag {
+    FILE *fp;
+    long count;
+    int order;
+} run_t;
+
+/* buffered reader over one run during a merge */
+typedef struct cursor_tag {
+    run_t *run;
+    int index;          /* position among the runs being merged, for ties */
+    run_rec_t *buf;
+    int buf_len;
+    int buf_pos;
+    long left;          /* records not yet loaded into buf */
+    int64_t key;
+} cursor_t;
+
+static const char *tmpdir = ".";
+static int by_gen = 1;
+static long bytes_written = 0;
+static long bytes_read = 0;
+
+static double ms_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: ./extsort [-m budget] [-k fanin] [-T tmpdir] [-s gen|ip] < commands\n");
+    fprintf(stderr, "\t-m: memory budget in bytes (K, M, G suffixes), default 64M\n");
+    fprintf(stderr, "\t-k: runs merged per pass, default 16\n");
+    fprintf(stderr, "\t-T: directory for run files, default $TMPDIR or .\n");
+    fprintf(stderr, "\t-s: sort chunks on this field as they spill\n");
+    exit(1);
+}
+
+static long parse_size(const char *s)
+{
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (*end == 'K' || *end == 'k') v <<= 10;
+    else if (*end == 'M' || *end == 'm') v <<= 20;
+    else if (*end == 'G' || *end == 'g') v <<= 30;
+    else if (*end != '\0') usage();
+    return v;
+}
+
+/* merge order: gen ascending or ip descending, as ids_sort_gen/ip */
+static int64_t rec_key(const run_rec_t *r)
+{
+    return by_gen ? (int64_t) r->generator_id : -(int64_t) r->dest_ip_addr;
+}
+
+/* ===== run files ===== */
+
+static run_t *run_create(int order)
+{
+    char path[MAXLINE];
+    snprintf(path, sizeof(path), "%s/extsort.XXXXXX", tmpdir);
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("extsort: cannot create run file");
+        exit(1);
+    }
+    unlink(path);   /* the file goes away when it is closed */
+    run_t *run = (run_t *) calloc(1, sizeof(run_t));
+    assert(run);
+    run->fp = fdopen(fd, "w+b");
+    assert(run->fp);
+    run->order = order;
+    return run;
+}
+
+static void run_write(run_t *run, const run_rec_t *recs, int n)
+{
+    if (n == 0) return;
+    if (fwrite(recs, sizeof(run_rec_t), n, run->fp) != (size_t) n) {
+        perror("extsort: run write");
+        exit(1);
+    }
+    run->count += n;
+    bytes_written += (long) n * sizeof(run_rec_t);
+}
+
+static void run_read(run_t *run, run_rec_t *recs, int n)
+{
+    if (fread(recs, sizeof(run_rec_t), n, run->fp) != (size_t) n) {
+        perror("extsort: run read");
+        exit(1);
+    }
+    bytes_read += (long) n * sizeof(run_rec_t);
+}
+
+static void run_destroy(run_t *run)
+{
+    fclose(run->fp);
+    free(run);
+}
+
+/* spill a chunk as one run, sorted by order (ORDER_NONE keeps input
+ * order), and destroy it.  The chunk is compacted before the sort so its
+ * records are freed in allocation order afterwards; freeing them in sorted
+ * order scatters the next chunk across the heap.
+ */
+static run_t *spill_chunk(llist_t *chunk, int order, int sort_type)
+{
+    if (order != ORDER_NONE) llist_compact(chunk, LLCOMPACT_RECORDS);
+    if (order == ORDER_GEN) ids_sort_gen(chunk, sort_type);
+    if (order == ORDER_IP)  ids_sort_ip(chunk, sort_type);
+
+    run_t *run = run_create(order);
+    run_rec_t buf[IO_RECS];
+    int n = 0;
+    for (llist_elem_t *r = chunk->ll_front; r; r = r->ll_next) {
+        buf[n].generator_id = r->data_ptr->generator_id;
+        buf[n].dest_ip_addr = r->data_ptr->dest_ip_addr;
+        buf[n].timestamp = r->data_ptr->timestamp;
+        if (++n == IO_RECS) {
+            run_write(run, buf, n);
+            n = 0;
+        }
+    }
+    run_write(run, buf, n);
+    fflush(run->fp);
+    ids_cleanup(chunk);
+    return run;
+}
+
+/* read a spilled chunk back and spill it again sorted */
+static run_t *resort_run(run_t *run, int order, int sort_type)
+{
+    llist_t *chunk = ids_create("Queue");
+    rewind(run->fp);
+    run_rec_t buf[IO_RECS];
+    for (long i = 0; i < run->count; ) {
+        int want = run->count - i < IO_RECS ? (int) (run->count - i) : IO_RECS;
+        run_read(run, buf, want);
+        for (int j = 0; j < want; j++)
+            ids_append_rear_ts(chunk, buf[j].generator_id, buf[j].dest_ip_addr, buf[j].timestamp);
+        i += want;
+    }
+    run_destroy(run);
+    return spill_chunk(chunk, order, sort_type);
+}
+
+/* ===== k-way merge ===== */
+
+/* load the next buffer; returns 0 at end of run */
+static int cursor_fill(cursor_t *c, int cap)
+{
+    if (c->left == 0) return 0;
+    int want = c->left < cap ? (int) c->left : cap;
+    run_read(c->run, c->buf, want);
+    c->left -= want;
+    c->buf_len = want;
+    c->buf_pos = 0;
+    return 1;
+}
+
+static int cursor_before(const cursor_t *a, const cursor_t *b)
+{
+    return a->key < b->key || (a->key == b->key && a->index < b->index);
+}
+
+static void heap_sift_down(cursor_t **heap, int n, int i)
+{
+    for (;;) {
+        int best = i, l = 2 * i + 1, r = l + 1;
+        if (l < n && cursor_before(heap[l], heap[best])) best = l;
+        if (r < n && cursor_before(heap[r], heap[best])) best = r;
+        if (best == i) return;
+        cursor_t *t = heap[i]; heap[i] = heap[best]; heap[best] = t;
+        i = best;
+    }
+}
+
+/* merge runs[0..k) into one new run, buf_recs records per buffer; ties go
+ * to the lower-numbered run, so merging consecutive runs stays stable
+ */
+static run_t *merge_runs(run_t **runs, int k, int buf_recs)
+{
+    cursor_t *cur = (cursor_t *) calloc(k, sizeof(cursor_t));
+    cursor_t **heap = (cursor_t **) malloc(k * sizeof(cursor_t *));
+    run_rec_t *out = (run_rec_t *) malloc(buf_recs * sizeof(run_rec_t));
+    assert(cur && heap && out);
+
+    int n = 0;
+    for (int i = 0; i < k; i++) {
+        cur[i].run = runs[i];
+        cur[i].index = i;
+        cur[i].buf = (run_rec_t *) malloc(buf_recs * sizeof(run_rec_t));
+        assert(cur[i].buf);
+        cur[i].left = runs[i]->count;
+        rewind(runs[i]->fp);
+        if (cursor_fill(&cur[i], buf_recs)) {
+            cur[i].key = rec_key(&cur[i].buf[0]);
+            heap[n++] = &cur[i];
+        }
+    }
+    for (int i = n / 2 - 1; i >= 0; i--) heap_sift_down(heap, n, i);
+
+    run_t *dst = run_create(runs[0]->order);
+    int nout = 0;
+    while (n > 0) {
+        cursor_t *c = heap[0];
+        out[nout++] = c->buf[c->buf_pos++];
+        if (nout == buf_recs) {
+            run_write(dst, out, nout);
+            nout = 0;
+        }
+        if (c->buf_pos < c->buf_len || cursor_fill(c, buf_recs)) {
+            c->key = rec_key(&c->buf[c->buf_pos]);
+        } else {
+            heap[0] = heap[--n];
+        }
+        heap_sift_down(heap, n, 0);
+    }
+    run_write(dst, out, nout);
+    fflush(dst->fp);
+
+    for (int i = 0; i < k; i++) {
+        free(cur[i].buf);
+        run_destroy(runs[i]);
+    }
+    free(out);
+    free(heap);
+    free(cur);
+    return dst;
+}
+
+/* merge passes over runs[0..nruns) until one run is left */
+static run_t *merge_all(run_t **runs, int nruns, int fanin, long budget, int *passes)
+{
+    *passes = 0;
+    while (nruns > 1) {
+        /* k input buffers plus one output buffer share the budget */
+        int buf_recs = (int) (budget / ((long) (fanin + 1) * sizeof(run_rec_t)));
+        if (buf_recs < 8) buf_recs = 8;
+        int nnext = 0;
+        for (int i = 0; i < nruns; i += fanin) {
+            int k = nruns - i < fanin ? nruns - i : fanin;
+            runs[nnext++] = (k == 1) ? runs[i] : merge_runs(runs + i, k, buf_recs);
+        }
+        nruns = nnext;
+        (*passes)++;
+    }
+    return runs[0];
+}
+
+static void print_run(run_t *run)
+{
+    if (run->count == 0) {
+        printf("Queue is empty\n\n");
+        return;
+    }
+    printf("Queue contains %ld record%s\n", run->count, run->count == 1 ? "." : "s.");
+    fflush(stdout);
+    recout_t *o = recout_open(STDOUT_FILENO, 0);
+    rewind(run->fp);
+    run_rec_t buf[IO_RECS];
+    for (long i = 0; i < run->count; ) {
+        int want = run->count - i < IO_RECS ? (int) (run->count - i) : IO_RECS;
+        run_read(run, buf, want);
+        for (int j = 0; j < want; j++) {
+            alert_t rec;
+            memset(&rec, 0, sizeof(rec));
+            rec.generator_id = buf[j].generator_id;
+            rec.dest_ip_addr = buf[j].dest_ip_addr;
+            rec.timestamp = buf[j].timestamp;
+            recout_text(o, ++i, &rec);
+        }
+    }
+    recout_str(o, "\n");
+    recout_close(o);
+}
+
+int main(int argc, char *argv[])
+{
+    long budget = DEFAULT_BUDGET;
+    int fanin = DEFAULT_FANIN;
+    int spill_order = ORDER_NONE;
+    int opt;
+
+    if (getenv("TMPDIR")) tmpdir = getenv("TMPDIR");
+    while ((opt = getopt(argc, argv, "m:k:T:s:")) != -1) {
+        switch (opt) {
+            case 'm': budget = parse_size(optarg); break;
+            case 'k': fanin = atoi(optarg); break;
+            case 'T': tmpdir = optarg; break;
+            case 's':
+                if (strcmp(optarg, "gen") == 0)     spill_order = ORDER_GEN;
+                else if (strcmp(optarg, "ip") == 0) spill_order = ORDER_IP;
+                else usage();
+                break;
+            default:  usage();
+        }
+    }
+    if (budget <= 0 || fanin < 2) usage();
+
+    long chunk_cap = budget / BYTES_PER_RECORD;
+    if (chunk_cap < 2) chunk_cap = 2;
+
+    llist_t *chunk = ids_create("Queue");
+    run_t **runs = NULL;
+    int nruns = 0, runs_cap = 0;
+    int sort_type = 0;
+    long total = 0;
+    run_t *sorted = NULL;
+    int passes = 0;
+    char line[MAXLINE];
+
+    while (fgets(line, MAXLINE, stdin) != NULL) {
+        if (line[0] == '\n' || line[0] == '#') continue;
+        char cmd[64] = {0};
+        if (sscanf(line, "%63s", cmd) != 1) continue;
+
+        if (strcmp(cmd, "APPENDREAR") == 0) {
+            int gen, ip, ts = 0;
+            if (sscanf(line, "%*s %d %d %d", &gen, &ip, &ts) < 2) continue;
+            if (sort_type) {
+                fprintf(stderr, "extsort: APPENDREAR after the sort skipped\n");
+                continue;
+            }
+            ids_append_rear_ts(chunk, gen, ip, ts);
+            total++;
+            if (llist_entries(chunk) == chunk_cap) {
+                if (nruns + 1 >= runs_cap) {
+                    runs_cap = runs_cap ? 2 * runs_cap : 16;
+                    runs = (run_t **) realloc(runs, runs_cap * sizeof(run_t *));
+                    assert(runs);
+                }
+                runs[nruns++] = spill_chunk(chunk, spill_order, 7);
+                chunk = ids_create("Queue");
+            }
+
+        } else if (strcmp(cmd, "SORTGEN") == 0 || strcmp(cmd, "SORTIP") == 0) {
+            int t;
+            if (sscanf(line, "%*s %d", &t) != 1 || sort_type) continue;
+            sort_type = t;
+            by_gen = (strcmp(cmd, "SORTGEN") == 0);
+            int order = by_gen ? ORDER_GEN : ORDER_IP;
+
+            double t0 = ms_now();
+            for (int i = 0; i < nruns; i++) {
+                if (runs[i]->order != order) runs[i] = resort_run(runs[i], order, sort_type);
+            }
+            if (nruns == runs_cap) {
+                runs = (run_t **) realloc(runs, ++runs_cap * sizeof(run_t *));
+                assert(runs);
+            }
+            if (llist_entries(chunk) > 0 || nruns == 0) {
+                runs[nruns++] = spill_chunk(chunk, order, sort_type);
+                chunk = ids_create("Queue");
+            }
+            int spilled = nruns;
+            sorted = merge_all(runs, nruns, fanin, budget, &passes);
+            nruns = spilled;
+            double t1 = ms_now();
+            printf("%ld\t%.6f\t%d\n", total, t1 - t0, t);
+            fflush(stdout);
+
+        } else if (strcmp(cmd, "PRINTQ") == 0) {
+            if (sorted) print_run(sorted);
+            else fprintf(stderr, "extsort: PRINTQ before the sort skipped\n");
+
+        } else if (strcmp(cmd, "QUIT") == 0) {
+            break;
+        }
+    }
+
+    fprintf(stderr, "extsort: %ld records, %d runs of up to %ld, %d merge passes, "
+            "%ld bytes written, %ld bytes read\n",
+            total, nruns, chunk_cap, passes, bytes_written, bytes_read);
+
+    /* input that ended without a sort leaves its chunks unmerged */
+    if (sorted) run_destroy(sorted);
+    else for (int i = 0; i < nruns; i++) run_destroy(runs[i]);
+    free(runs);
+    ids_cleanup(chunk);
+    return 0;
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,90 @@
+/* hdrhist.c
+ * ECE 2230 Fall 2025
+ * MP3 — latency histograms for lab3 -H
+ *
+ * Purpose:
+ *   Log-linear buckets: index v for v < 2*SUB, otherwise the value's top
+ *   HDRHIST_SUB_BITS+1 bits select a bucket within its power of two.
+ *   Percentiles walk the counts once and report the bucket's upper edge,
+ *   so a tail is never understated.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "hdrhist.h"
+
+/* ===== private helpers ===== */
+static int bucket_of(long long v);
+static long long bucket_high(int idx);
+
+hdrhist_t *hdrhist_construct(void)
+{
+    hdrhist_t *h = (hdrhist_t *) malloc(sizeof(hdrhist_t));
+    assert(h);
+    hdrhist_reset(h);
+    return h;
+}
+
+void hdrhist_destruct(hdrhist_t *h)
+{
+    assert(h);
+    free(h);
+}
+
+void hdrhist_reset(hdrhist_t *h)
+{
+    assert(h);
+    memset(h, 0, sizeof(hdrhist_t));
+}
+
+void hdrhist_record(hdrhist_t *h, long long ns)
+{
+    assert(h);
+    if (ns < 0) ns = 0;
+    if (h->count == 0 || ns < h->min) h->min = ns;
+    if (ns > h->max) h->max = ns;
+    h->count++;
+    h->counts[bucket_of(ns)]++;
+}
+
+long long hdrhist_percentile(const hdrhist_t *h, double pct)
+{
+    assert(h);
+    if (h->count == 0) return 0;
+    if (pct >= 100.0) return h->max;
+    double rank = pct / 100.0 * h->count;
+    long want = (long) rank;
+    if (want < rank) want++;
+    if (want < 1) want = 1;
+    long seen = 0;
+    for (int i = 0; i < HDRHIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= want) {
+            long long high = bucket_high(i);
+            return high < h->max ? high : h->max;
+        }
+    }
+    return h->max;
+}
+
+/* ===== helpers ===== */
+
+static int bucket_of(long long v)
+{
+    if (v < 2 * HDRHIST_SUB) return (int) v;
+    int top = 63 - __builtin_clzll((unsigned long long) v);
+    int shift = top - HDRHIST_SUB_BITS;
+    if (shift > HDRHIST_MAX_SHIFT) return HDRHIST_BUCKETS - 1;
+    return HDRHIST_SUB * shift + (int) (v >> shift);
+}
+
+static long long bucket_high(int idx)
+{
+    if (idx < 2 * HDRHIST_SUB) return idx;
+    int shift = idx / HDRHIST_SUB - 1;
+    long long m = idx - (long long) HDRHIST_SUB * shift;
+    return ((m + 1) << shift) - 1;
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,37 @@
+/* hdrhist.h
+ * Fixed-size latency histogram in the HDR style
+ *
+ * Values (nanoseconds) below 128 get a bucket each; above that every
+ * power of two is split into 64 equal buckets, so a reported percentile
+ * is within 1/64 (1.6%) of the true sample at any magnitude up to about
+ * 2^40 ns.  Recording is a shift and an increment with no allocation.
+ * Count, min and max are kept exactly.
+ */
+#ifndef HDRHIST_H
+#define HDRHIST_H
+
+#define HDRHIST_SUB_BITS  6
+#define HDRHIST_SUB       (1 << HDRHIST_SUB_BITS)
+#define HDRHIST_MAX_SHIFT 34
+#define HDRHIST_BUCKETS   (HDRHIST_SUB * (HDRHIST_MAX_SHIFT + 2))
+
+typedef struct hdrhist_tag {
+    long count;
+    long long min;
+    long long max;
+    long counts[HDRHIST_BUCKETS];
+} hdrhist_t;
+
+hdrhist_t * hdrhist_construct(void);
+void        hdrhist_destruct(hdrhist_t *h);
+void        hdrhist_reset(hdrhist_t *h);
+
+/* negative values count as 0; huge ones land in the last bucket */
+void        hdrhist_record(hdrhist_t *h, long long ns);
+
+/* smallest bucket upper edge with at least pct percent of the samples
+ * at or below it (pct in 0..100; 100 gives the exact max); 0 if empty
+ */
+long long   hdrhist_percentile(const hdrhist_t *h, double pct);
+
+#endif
@@ -8,21 +8,34 @@
  * Notes:
  *   - ids_record_fill now checks fgets() return values (no warnings).
  *   - Adds MP3 fast helpers: ids_append_rear_fast, ids_sort_gen, ids_sort_ip.
+ *   - ids_cols_* run the same fast path against the columnar store.
+ *   - PRINTQ output and DUMPQ files go through recout's buffer, one pass
+ *     over the list; ids_cold_print streams a cold tier's blocks first.
  */
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
 
 #include "llist.h"
 #include "ids_support.h"
+#include "memacct.h"
+#include "recout.h"
+#include "coldtier.h"
 
 #define MAXLINE 256
 
 /* private helpers */
 static void ids_record_fill(alert_t *rec);      /* collect input from user */
-static void ids_print_alert_rec(alert_t *rec);  /* print one record */
+static void print_count(recout_t *o, const char *list_type, long n);
+static recout_t *dump_open(const char *path);
+static double ms_now(void);
+static int order_differs(llist_t *a, llist_t *b, int (*fcomp)(const alert_t *, const alert_t *));
+static int order_broken(llist_t *L, int (*fcomp)(const alert_t *, const alert_t *));
 
 /* ===== Comparators / matchers ===== */
 
@@ -50,31 +63,76 @@ int ids_match_destip(const alert_t *rec_a, const alert_t *rec_b)
     return (rec_a->dest_ip_addr == rec_b->dest_ip_addr) ? 0 : 1;
 }
 
+int ids_key_genid(const alert_t *rec)
+{
+    return rec->generator_id;
+}
+
+int ids_key_destip(const alert_t *rec)
+{
+    return rec->dest_ip_addr;
+}
+
 /* ===== Printing ===== */
 
 void ids_print(llist_t *list_ptr, const char *list_type)
+{
+    ids_cold_print(NULL, list_ptr, list_type);
+}
+
+void ids_cold_print(coldtier_t *ct, llist_t *list_ptr, const char *list_type)
 {
     assert(strcmp(list_type, "List")==0 || strcmp(list_type, "Queue")==0);
     int n = llist_entries(list_ptr);
+    long cold = ct ? coldtier_entries(ct) : 0;
+    llist_link(list_ptr);
+
+    fflush(stdout);
+    recout_t *o = recout_open(STDOUT_FILENO, 0);
+    print_count(o, list_type, cold + n);
+    long i = 1;
+    for (int b = 0; ct && b < ct->ct_nblocks; b++) {
+        int m;
+        const alert_t *recs = coldtier_block(ct, b, &m);
+        for (int k = 0; k < m; k++) recout_text(o, i++, &recs[k]);
+    }
+    for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next) recout_text(o, i++, r->data_ptr);
+    recout_str(o, "\n");
+    recout_close(o);
+}
 
+void ids_cold_stats(coldtier_t *ct)
+{
+    long n = ct ? coldtier_entries(ct) : 0;
     if (n == 0) {
-        printf("%s is empty\n", list_type);
-    } else {
-        printf("%s contains %d record%s\n", list_type, n, n==1 ? "." : "s.");
-    }
-    for (int i = 0; i < n; i++) {
-        printf("%d: ", i+1);
-        alert_t *rec_ptr = llist_access(list_ptr, i);
-        ids_print_alert_rec(rec_ptr);
+        printf("Cold tier is empty\n");
+        return;
     }
-    printf("\n");
+    size_t bytes = coldtier_bytes(ct);
+    double hot = (double) (sizeof(alert_t) + sizeof(llist_elem_t));
+    printf("Cold tier: %ld records in %d blocks, %zu bytes (%.2f per record, hot %.0f: %.1fx)\n",
+           n, ct->ct_nblocks, bytes, (double) bytes / n, hot, hot * n / bytes);
+}
+
+int ids_dump(llist_t *list_ptr, const char *path)
+{
+    assert(list_ptr && path);
+    int n = llist_entries(list_ptr);
+    llist_link(list_ptr);
+    recout_t *o = dump_open(path);
+    if (o == NULL) return -1;
+    for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next) recout_binary(o, r->data_ptr);
+    int fd = o->fd;
+    int ret = recout_close(o);
+    if (close(fd) != 0) ret = -1;
+    return ret == 0 ? n : -1;
 }
 
 /* ===== Queue ops (interactive MP2 path) ===== */
 
 void ids_add_rear(llist_t *list_ptr)
 {
-    alert_t *new_ptr = (alert_t *) calloc(1, sizeof(alert_t));
+    alert_t *new_ptr = (alert_t *) memacct_calloc(MEMACCT_RECORD, 1, sizeof(alert_t));
     assert(new_ptr);
     ids_record_fill(new_ptr);
 
@@ -85,7 +143,7 @@ void ids_add_rear(llist_t *list_ptr)
 
     if (found != NULL) {
         alert_t *old = llist_remove(list_ptr, pos);
-        free(old);
+        memacct_free(MEMACCT_RECORD, old, sizeof(alert_t));
         printf("Appended %d onto queue and removed old copy\n", new_ptr->dest_ip_addr);
     } else {
         printf("Appended %d onto queue\n", new_ptr->dest_ip_addr);
@@ -98,7 +156,7 @@ void ids_remove_front(llist_t *list_ptr)
     alert_t *rec_ptr = llist_remove(list_ptr, LLPOSITION_FRONT);
     if (rec_ptr) {
         printf("Deleted front with IP addr: %d\n", rec_ptr->dest_ip_addr);
-        free(rec_ptr);
+        memacct_free(MEMACCT_RECORD, rec_ptr, sizeof(alert_t));
     } else {
         printf("Queue empty, did not remove\n");
     }
@@ -106,9 +164,16 @@ void ids_remove_front(llist_t *list_ptr)
 
 /* ===== Create (sorted vs queue) ===== */
 
+void ids_register_compare(void)
+{
+    llist_register_compare(IDS_COMPARE_GENID_ID, ids_compare_genid);
+    llist_register_compare(IDS_COMPARE_DESTIP_ID, ids_compare_destip);
+}
+
 llist_t *ids_create(const char *list_type)
 {
     assert(strcmp(list_type, "List")==0 || strcmp(list_type, "Queue")==0);
+    ids_register_compare();
     if (strcmp(list_type, "List") == 0)  return llist_construct(ids_compare_genid);
     if (strcmp(list_type, "Queue") == 0) return llist_construct(NULL);
     printf("ERROR, invalid list type %s\n", list_type);
@@ -119,7 +184,7 @@ llist_t *ids_create(const char *list_type)
 
 void ids_add(llist_t *list_ptr)
 {
-    alert_t *new_ptr = (alert_t *) calloc(1, sizeof(alert_t));
+    alert_t *new_ptr = (alert_t *) memacct_calloc(MEMACCT_RECORD, 1, sizeof(alert_t));
     assert(new_ptr);
     ids_record_fill(new_ptr);
     llist_insert_sorted(list_ptr, new_ptr);
@@ -161,7 +226,7 @@ void ids_remove_gen(llist_t *list_ptr, int gen_id)
         alert_t *rec_ptr = llist_access(list_ptr, i);
         if (rec_ptr->generator_id == gen_id) {
             alert_t *dead = llist_remove(list_ptr, i);
-            free(dead);
+            memacct_free(MEMACCT_RECORD, dead, sizeof(alert_t));
             removed++;
         } else {
             i++;
@@ -178,7 +243,7 @@ void ids_remove_ip(llist_t *list_ptr, int dest_ip)
         alert_t *rec_ptr = llist_access(list_ptr, i);
         if (rec_ptr->dest_ip_addr == dest_ip) {
             alert_t *dead = llist_remove(list_ptr, i);
-            free(dead);
+            memacct_free(MEMACCT_RECORD, dead, sizeof(alert_t));
             removed++;
         } else {
             i++;
@@ -192,7 +257,7 @@ void ids_scan(llist_t *list_ptr, int thresh)
 {
     int sets = 0;
     int n = llist_entries(list_ptr);
-    int *seen = (int *) calloc(n, sizeof(int));
+    int *seen = (int *) memacct_calloc(MEMACCT_SCRATCH, n, sizeof(int));
     assert(seen);
 
     for (int i = 0; i < n; i++) {
@@ -208,7 +273,7 @@ void ids_scan(llist_t *list_ptr, int thresh)
         }
         if (cnt >= thresh) { printf("A set with generator %d has %d alerts\n", g, cnt); sets++; }
     }
-    free(seen);
+    memacct_free(MEMACCT_SCRATCH, seen, n * sizeof(int));
 
     if (sets) printf("Scan found %d sets\n", sets);
     else      printf("Scan found no alerts with >= %d matches\n", thresh);
@@ -267,8 +332,28 @@ static void ids_record_fill(alert_t *rec)
     printf("\n");
 }
 
+/* the line before a PRINTQ listing */
+static void print_count(recout_t *o, const char *list_type, long n)
+{
+    recout_str(o, list_type);
+    if (n == 0) {
+        recout_str(o, " is empty\n");
+    } else {
+        recout_str(o, " contains ");
+        recout_int(o, n);
+        recout_str(o, n == 1 ? " record.\n" : " records.\n");
+    }
+}
+
+static recout_t *dump_open(const char *path)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return NULL;
+    return recout_open(fd, 0);
+}
+
 /* print one alert */
-static void ids_print_alert_rec(alert_t *rec)
+void ids_print_alert_rec(alert_t *rec)
 {
     assert(rec);
     printf("[%d:%d:%d] (gen, sig, rev): ", rec->generator_id, rec->signature_id, rec->revision_id);
@@ -276,15 +361,47 @@ static void ids_print_alert_rec(alert_t *rec)
     printf(" Src: %d, Time: %d\n", rec->src_port_num, rec->timestamp);
 }
 
+static double ms_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+/* first record (from 1) where a and b disagree under fcomp, or 0 */
+static int order_differs(llist_t *a, llist_t *b, int (*fcomp)(const alert_t *, const alert_t *))
+{
+    int pos = 1;
+    llist_elem_t *x = a->ll_front, *y = b->ll_front;
+    for (; x && y; x = x->ll_next, y = y->ll_next, pos++)
+        if (fcomp(x->data_ptr, y->data_ptr) != 0) return pos;
+    return (x || y) ? pos : 0;
+}
+
+/* first record (from 2) that fcomp puts before its predecessor, or 0 */
+static int order_broken(llist_t *L, int (*fcomp)(const alert_t *, const alert_t *))
+{
+    int pos = 2;
+    for (llist_elem_t *r = L->ll_front; r && r->ll_next; r = r->ll_next, pos++)
+        if (fcomp(r->ll_next->data_ptr, r->data_ptr) == 1) return pos;
+    return 0;
+}
+
 /* ===== MP3 fast-path helpers (used by lab3 / geninput / longrun.sh) ===== */
 
 void ids_append_rear_fast(llist_t *list_ptr, int generator_id, int dest_ip_addr)
 {
-    /* Build minimal record: only fields required by comparators. */
-    alert_t *rec = (alert_t *) calloc(1, sizeof(alert_t));
+    ids_append_rear_ts(list_ptr, generator_id, dest_ip_addr, 0);
+}
+
+void ids_append_rear_ts(llist_t *list_ptr, int generator_id, int dest_ip_addr, int timestamp)
+{
+    /* Build minimal record: only fields required by comparators and retention. */
+    alert_t *rec = (alert_t *) memacct_calloc(MEMACCT_RECORD, 1, sizeof(alert_t));
     assert(rec);
     rec->generator_id = generator_id;
     rec->dest_ip_addr = dest_ip_addr;
+    rec->timestamp = timestamp;
     llist_insert(list_ptr, rec, LLPOSITION_BACK);
     /* No printing; matches generator's expected quiet behavior. */
 }
@@ -292,13 +409,120 @@ void ids_append_rear_fast(llist_t *list_ptr, int generator_id, int dest_ip_addr)
 void ids_sort_gen(llist_t *list_ptr, int sort_type)
 {
     /* Sort the list by generator id using the ADT's sort */
-    llist_sort(list_ptr, sort_type, ids_compare_genid);
+    if (sort_type == 7)
+        llist_sort_by_key(list_ptr, ids_key_genid, 0, ids_compare_genid);
+    else
+        llist_sort(list_ptr, sort_type, ids_compare_genid);
 }
 
 void ids_sort_ip(llist_t *list_ptr, int sort_type)
 {
     /* Sort the list by destination IP using the ADT's sort */
-    llist_sort(list_ptr, sort_type, ids_compare_destip);
+    if (sort_type == 7)
+        llist_sort_by_key(list_ptr, ids_key_destip, 1, ids_compare_destip);
+    else
+        llist_sort(list_ptr, sort_type, ids_compare_destip);
+}
+
+/* every type sorts its own clone of the same input.  Unstable types may
+ * order ties differently, so results are compared by key.
+ */
+void ids_bench_all(llist_t *list_ptr, int bygen, const int *types, int ntypes)
+{
+    int (*fcomp)(const alert_t *, const alert_t *) = bygen ? ids_compare_genid : ids_compare_destip;
+    const char *field = bygen ? "gen" : "ip";
+    llist_t *ref = NULL;
+    int ref_type = 0, bad = 0;
+
+    for (int i = 0; i < ntypes; i++) {
+        llist_t *L = llist_clone(list_ptr, 0);
+        double t0 = ms_now();
+        if (bygen) ids_sort_gen(L, types[i]);
+        else       ids_sort_ip(L, types[i]);
+        double t1 = ms_now();
+        printf("%d\t%.6f\t%d\n", llist_entries(L), t1 - t0, types[i]);
+        fflush(stdout);
+
+        int pos;
+        if (ref == NULL) {
+            ref = L;
+            ref_type = types[i];
+            if ((pos = order_broken(L, fcomp)) != 0) {
+                printf("BENCHALL %s: type %d out of order at record %d\n", field, types[i], pos);
+                bad++;
+            }
+            continue;
+        }
+        if ((pos = order_differs(ref, L, fcomp)) != 0) {
+            printf("BENCHALL %s: type %d differs from type %d at record %d\n",
+                   field, types[i], ref_type, pos);
+            bad++;
+        }
+        llist_destruct(L);
+    }
+    if (ref) llist_destruct(ref);
+    if (bad == 0) printf("BENCHALL %s: %d sort types agree\n", field, ntypes);
+}
+
+/* ===== Columnar store adapters (lab3 -c) ===== */
+
+void ids_cols_print(colstore_t *cs, const char *list_type)
+{
+    assert(strcmp(list_type, "List")==0 || strcmp(list_type, "Queue")==0);
+    int n = colstore_entries(cs);
+
+    fflush(stdout);
+    recout_t *o = recout_open(STDOUT_FILENO, 0);
+    print_count(o, list_type, n);
+    for (int i = 0; i < n; i++) {
+        alert_t rec;
+        colstore_get(cs, i, &rec);
+        recout_text(o, i+1, &rec);
+    }
+    recout_str(o, "\n");
+    recout_close(o);
+}
+
+int ids_cols_dump(colstore_t *cs, const char *path)
+{
+    assert(cs && path);
+    int n = colstore_entries(cs);
+    recout_t *o = dump_open(path);
+    if (o == NULL) return -1;
+    for (int i = 0; i < n; i++) {
+        alert_t rec;
+        colstore_get(cs, i, &rec);
+        recout_binary(o, &rec);
+    }
+    int fd = o->fd;
+    int ret = recout_close(o);
+    if (close(fd) != 0) ret = -1;
+    return ret == 0 ? n : -1;
+}
+
+void ids_cols_append_rear_fast(colstore_t *cs, int generator_id, int dest_ip_addr)
+{
+    ids_cols_append_rear_ts(cs, generator_id, dest_ip_addr, 0);
+}
+
+void ids_cols_append_rear_ts(colstore_t *cs, int generator_id, int dest_ip_addr, int timestamp)
+{
+    alert_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.generator_id = generator_id;
+    rec.dest_ip_addr = dest_ip_addr;
+    rec.timestamp = timestamp;
+    colstore_append(cs, &rec);
+}
+
+void ids_cols_sort_gen(colstore_t *cs)
+{
+    colstore_sort(cs, COL_GENERATOR_ID, 0);    /* ascending, as ids_compare_genid */
+}
+
+void ids_cols_sort_ip(colstore_t *cs)
+{
+    colstore_sort(cs, COL_DEST_IP_ADDR, 1);    /* descending, as ids_compare_destip */
 }
 
 /* vi:set ts=8 sts=4 sw=4 et: */
@@ -3,14 +3,26 @@
 
 #include "llist.h"
 #include "datatypes.h"   /* defines alert_t (aka data_t) */
+#include "colstore.h"
+#include "coldtier.h"
 
 /* Comparators / matchers */
 int ids_compare_genid(const alert_t *rec_a, const alert_t *rec_b);
 int ids_compare_destip(const alert_t *rec_a, const alert_t *rec_b);
 int ids_match_destip(const alert_t *rec_a, const alert_t *rec_b);
 
+/* Comparator ids stored in list snapshot files (llist_save) */
+#define IDS_COMPARE_GENID_ID   1
+#define IDS_COMPARE_DESTIP_ID  2
+void ids_register_compare(void);   /* ids_create calls this */
+
+/* Sort keys for llist_sort_by_key (sort type 7) */
+int ids_key_genid(const alert_t *rec);
+int ids_key_destip(const alert_t *rec);
+
 /* MP2-style interactive helpers */
 void   ids_print(llist_t *list_ptr, const char *list_type);
+void   ids_print_alert_rec(alert_t *rec);   /* one PRINTQ record line */
 void   ids_add_rear(llist_t *list_ptr);
 void   ids_remove_front(llist_t *list_ptr);
 llist_t *ids_create(const char *list_type);
@@ -25,7 +37,39 @@ void   ids_cleanup(llist_t *list_ptr);
 
 /* MP3 fast-path helpers (called by lab3 for scripted runs) */
 void   ids_append_rear_fast(llist_t *list_ptr, int generator_id, int dest_ip_addr);
+void   ids_append_rear_ts(llist_t *list_ptr, int generator_id, int dest_ip_addr, int timestamp);
 void   ids_sort_gen(llist_t *list_ptr, int sort_type);
 void   ids_sort_ip(llist_t *list_ptr, int sort_type);
+/* write the records in list order to path as packed data_t (recout.h's
+ * binary dump); returns the number written, or -1 on an I/O error
+ */
+int    ids_dump(llist_t *list_ptr, const char *path);
+/* PRINTQ over a cold tier then the list, numbered as one queue; ct may
+ * be NULL
+ */
+void   ids_cold_print(coldtier_t *ct, llist_t *list_ptr, const char *list_type);
+/* COLD: the tier's size against the same records as list nodes; ct may
+ * be NULL
+ */
+void   ids_cold_stats(coldtier_t *ct);
+/* BENCHALL: sort a shallow clone of the list by gen (bygen) or ip with
+ * each sort type in turn, printing each timing line, then check that the
+ * results hold the same keys in the same order
+ */
+void   ids_bench_all(llist_t *list_ptr, int bygen, const int *types, int ntypes);
+
+/* Same helpers against the columnar store (lab3 -c).  There is one
+ * columnar sort, the stable radix sort of colstore_sort, so the sorts take
+ * no sort type and lab3 reports them as IDS_COLS_SORT_TYPE.  Equal keys
+ * keep queue order, as with list sort types 1, 6 and 7; the unstable list
+ * types may order them differently.
+ */
+#define IDS_COLS_SORT_TYPE 9
+void   ids_cols_print(colstore_t *cs, const char *list_type);
+void   ids_cols_append_rear_fast(colstore_t *cs, int generator_id, int dest_ip_addr);
+void   ids_cols_append_rear_ts(colstore_t *cs, int generator_id, int dest_ip_addr, int timestamp);
+void   ids_cols_sort_gen(colstore_t *cs);
+void   ids_cols_sort_ip(colstore_t *cs);
+int    ids_cols_dump(colstore_t *cs, const char *path);
 
 #endif /* IDS_SUPPORT_H */
@@ -0,0 +1,397 @@
+/* ilist.c
+ * ECE 2230 Fall 2025
+ * MP3 — Index-linked List ADT + Sorting
+ *
+ * Purpose:
+ *   Two-way list whose nodes sit in one growable arena and are linked by
+ *   32-bit indices, with the alert_t stored inline.  Removed slots go on
+ *   a free list and are reused by later inserts.  ilist_sort() provides
+ *   the five MP3 algorithms over index links.
+ */
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <assert.h>
+#include "ilist.h"
+
+/* Private sorted-state flags (same values as llist.c) */
+#define ILIST_SORTED    989898
+#define ILIST_UNSORTED  -898989
+
+#define ILIST_INIT_CAP  1024
+
+/* a sub-chain of the arena, used by the sorts */
+typedef struct ichain_tag {
+    uint32_t front;
+    uint32_t back;
+    int count;
+} ichain_t;
+
+/* ===== private helpers ===== */
+static uint32_t node_alloc(ilist_t *L);
+static void node_release(ilist_t *L, uint32_t i);
+static uint32_t walk_to(ilist_t *L, int pos_index);
+static void link_before(ilist_t *L, ichain_t *C, uint32_t node, uint32_t before);
+static void chain_detach(ilist_node_t *N, ichain_t *C, uint32_t node);
+static void chain_push_back(ilist_node_t *N, ichain_t *C, uint32_t node);
+static uint32_t chain_pop_front(ilist_node_t *N, ichain_t *C);
+static int comes_before(ilist_t *L, uint32_t a, uint32_t b);
+
+static void insertion_sort_chain(ilist_t *L, ichain_t *C);
+static void selection_sort_recur(ilist_t *L, ichain_t *work, ichain_t *out);
+static void selection_sort_iterative(ilist_t *L, ichain_t *C);
+static void mergesort_chain(ilist_t *L, ichain_t *C);
+static void quick_sort_array(ilist_t *L, ichain_t *C);
+
+static ichain_t chain_of(ilist_t *L)
+{
+    ichain_t C = { L->il_front, L->il_back, L->il_entry_count };
+    return C;
+}
+
+static void set_chain(ilist_t *L, ichain_t C)
+{
+    L->il_front = C.front;
+    L->il_back = C.back;
+    L->il_entry_count = C.count;
+}
+
+/* ===== core ADT functions ===== */
+
+data_t *ilist_access(ilist_t *list_ptr, int pos_index)
+{
+    assert(list_ptr);
+    if (list_ptr->il_entry_count == 0) return NULL;
+
+    if (pos_index == LLPOSITION_FRONT) pos_index = 0;
+    if (pos_index == LLPOSITION_BACK) pos_index = list_ptr->il_entry_count - 1;
+    if (pos_index < 0 || pos_index >= list_ptr->il_entry_count) return NULL;
+
+    return &list_ptr->il_nodes[walk_to(list_ptr, pos_index)].il_data;
+}
+
+ilist_t *ilist_construct(int (*fcomp)(const data_t *, const data_t *))
+{
+    ilist_t *L = (ilist_t *) calloc(1, sizeof(ilist_t));
+    assert(L);
+    L->il_free = L->il_front = L->il_back = ILIST_NIL;
+    L->compare_fun = fcomp;
+    L->il_sorted_state = (fcomp ? ILIST_SORTED : ILIST_UNSORTED);
+    return L;
+}
+
+void ilist_destruct(ilist_t *list_ptr)
+{
+    assert(list_ptr);
+    free(list_ptr->il_nodes);
+    free(list_ptr->il_sort_arena);
+    free(list_ptr);
+}
+
+data_t *ilist_elem_find(ilist_t *list_ptr, data_t *elem_ptr, int *pos_index,
+                        int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(list_ptr && pos_index);
+    ilist_node_t *N = list_ptr->il_nodes;
+    *pos_index = -1;
+    int idx = 0;
+    for (uint32_t r = list_ptr->il_front; r != ILIST_NIL; r = N[r].il_next, idx++) {
+        if (fcomp(elem_ptr, &N[r].il_data) == 0) {
+            *pos_index = idx;
+            return &N[r].il_data;
+        }
+    }
+    return NULL;
+}
+
+int ilist_entries(ilist_t *list_ptr)
+{
+    assert(list_ptr && list_ptr->il_entry_count >= 0);
+    return list_ptr->il_entry_count;
+}
+
+void ilist_insert(ilist_t *list_ptr, data_t *elem_ptr, int pos_index)
+{
+    assert(list_ptr && elem_ptr);
+    assert(pos_index == LLPOSITION_FRONT || pos_index == LLPOSITION_BACK || pos_index >= 0);
+
+    uint32_t node = node_alloc(list_ptr);
+    list_ptr->il_nodes[node].il_data = *elem_ptr;
+    free(elem_ptr);
+
+    uint32_t before;
+    if (pos_index == LLPOSITION_FRONT || pos_index == 0)
+        before = list_ptr->il_front;
+    else if (pos_index == LLPOSITION_BACK || pos_index >= list_ptr->il_entry_count)
+        before = ILIST_NIL;
+    else
+        before = walk_to(list_ptr, pos_index);
+
+    ichain_t C = chain_of(list_ptr);
+    link_before(list_ptr, &C, node, before);
+    set_chain(list_ptr, C);
+    if (list_ptr->il_sorted_state == ILIST_SORTED) list_ptr->il_sorted_state = ILIST_UNSORTED;
+}
+
+void ilist_insert_sorted(ilist_t *list_ptr, data_t *elem_ptr)
+{
+    assert(list_ptr && list_ptr->compare_fun && list_ptr->il_sorted_state == ILIST_SORTED);
+
+    uint32_t node = node_alloc(list_ptr);
+    list_ptr->il_nodes[node].il_data = *elem_ptr;
+    free(elem_ptr);
+
+    ichain_t C = chain_of(list_ptr);
+    uint32_t r = C.front;
+    while (r != ILIST_NIL && !comes_before(list_ptr, node, r)) r = list_ptr->il_nodes[r].il_next;
+    link_before(list_ptr, &C, node, r);
+    set_chain(list_ptr, C);
+}
+
+data_t *ilist_remove(ilist_t *list_ptr, int pos_index)
+{
+    assert(list_ptr);
+    assert(pos_index == LLPOSITION_FRONT || pos_index == LLPOSITION_BACK || pos_index >= 0);
+
+    int n = list_ptr->il_entry_count;
+    if (n == 0) return NULL;
+    if (pos_index == LLPOSITION_FRONT) pos_index = 0;
+    if (pos_index == LLPOSITION_BACK) pos_index = n - 1;
+    if (pos_index >= n) return NULL;
+
+    uint32_t t = walk_to(list_ptr, pos_index);
+    ichain_t C = chain_of(list_ptr);
+    chain_detach(list_ptr->il_nodes, &C, t);
+    set_chain(list_ptr, C);
+
+    data_t *ret = (data_t *) malloc(sizeof(data_t));
+    assert(ret);
+    *ret = list_ptr->il_nodes[t].il_data;
+    node_release(list_ptr, t);
+    return ret;
+}
+
+/* ===== sorting ===== */
+
+void ilist_sort(ilist_t *list_ptr, int sort_type,
+                int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(list_ptr && fcomp);
+    list_ptr->compare_fun = fcomp;
+
+    int original_size = list_ptr->il_entry_count;
+    if (original_size > 1) {
+        ichain_t C = chain_of(list_ptr);
+        switch (sort_type) {
+            case 1: insertion_sort_chain(list_ptr, &C); break;
+            case 2: {
+                ichain_t out = { ILIST_NIL, ILIST_NIL, 0 };
+                selection_sort_recur(list_ptr, &C, &out);
+                C = out;
+                break;
+            }
+            case 3: selection_sort_iterative(list_ptr, &C); break;
+            case 5: quick_sort_array(list_ptr, &C); break;
+            default: mergesort_chain(list_ptr, &C); break;
+        }
+        set_chain(list_ptr, C);
+    }
+    assert(list_ptr->il_entry_count == original_size);
+    list_ptr->il_sorted_state = ILIST_SORTED;
+}
+
+/* ===== helpers ===== */
+
+static uint32_t node_alloc(ilist_t *L)
+{
+    if (L->il_free != ILIST_NIL) {
+        uint32_t i = L->il_free;
+        L->il_free = L->il_nodes[i].il_next;
+        return i;
+    }
+    if (L->il_used == L->il_cap) {
+        uint32_t cap = L->il_cap ? 2 * L->il_cap : ILIST_INIT_CAP;
+        assert(cap > L->il_cap && cap < ILIST_NIL);
+        L->il_nodes = (ilist_node_t *) realloc(L->il_nodes, cap * sizeof(ilist_node_t));
+        assert(L->il_nodes);
+        L->il_cap = cap;
+    }
+    return L->il_used++;
+}
+
+static void node_release(ilist_t *L, uint32_t i)
+{
+    L->il_nodes[i].il_next = L->il_free;
+    L->il_free = i;
+}
+
+static uint32_t walk_to(ilist_t *L, int pos_index)
+{
+    ilist_node_t *N = L->il_nodes;
+    uint32_t r;
+    if (pos_index <= L->il_entry_count / 2) {
+        r = L->il_front;
+        for (int i = 0; i < pos_index; i++) r = N[r].il_next;
+    } else {
+        r = L->il_back;
+        for (int i = L->il_entry_count - 1; i > pos_index; i--) r = N[r].il_prev;
+    }
+    return r;
+}
+
+/* link node into C ahead of before (ILIST_NIL appends) */
+static void link_before(ilist_t *L, ichain_t *C, uint32_t node, uint32_t before)
+{
+    ilist_node_t *N = L->il_nodes;
+    if (before == ILIST_NIL) {
+        chain_push_back(N, C, node);
+        return;
+    }
+    N[node].il_next = before;
+    N[node].il_prev = N[before].il_prev;
+    if (N[before].il_prev != ILIST_NIL) N[N[before].il_prev].il_next = node; else C->front = node;
+    N[before].il_prev = node;
+    C->count++;
+}
+
+static void chain_detach(ilist_node_t *N, ichain_t *C, uint32_t node)
+{
+    if (N[node].il_prev != ILIST_NIL) N[N[node].il_prev].il_next = N[node].il_next; else C->front = N[node].il_next;
+    if (N[node].il_next != ILIST_NIL) N[N[node].il_next].il_prev = N[node].il_prev; else C->back = N[node].il_prev;
+    N[node].il_prev = N[node].il_next = ILIST_NIL;
+    C->count--;
+}
+
+static void chain_push_back(ilist_node_t *N, ichain_t *C, uint32_t node)
+{
+    N[node].il_next = ILIST_NIL;
+    N[node].il_prev = C->back;
+    if (C->back != ILIST_NIL) N[C->back].il_next = node; else C->front = node;
+    C->back = node;
+    C->count++;
+}
+
+static uint32_t chain_pop_front(ilist_node_t *N, ichain_t *C)
+{
+    uint32_t node = C->front;
+    C->front = N[node].il_next;
+    if (C->front != ILIST_NIL) N[C->front].il_prev = ILIST_NIL; else C->back = ILIST_NIL;
+    N[node].il_next = N[node].il_prev = ILIST_NIL;
+    C->count--;
+    return node;
+}
+
+static int comes_before(ilist_t *L, uint32_t a, uint32_t b)
+{
+    return L->compare_fun(&L->il_nodes[a].il_data, &L->il_nodes[b].il_data) > 0;
+}
+
+/* ----- insertion sort into a second chain ----- */
+static void insertion_sort_chain(ilist_t *L, ichain_t *C)
+{
+    ichain_t sorted = { ILIST_NIL, ILIST_NIL, 0 };
+    while (C->count > 0) {
+        uint32_t node = chain_pop_front(L->il_nodes, C);
+        uint32_t r = sorted.front;
+        while (r != ILIST_NIL && !comes_before(L, node, r)) r = L->il_nodes[r].il_next;
+        link_before(L, &sorted, node, r);
+    }
+    *C = sorted;
+}
+
+/* ----- recursive selection sort (Standish 5.19/5.20) ----- */
+static void selection_sort_recur(ilist_t *L, ichain_t *work, ichain_t *out)
+{
+    if (work->count == 0) return;
+
+    ilist_node_t *N = L->il_nodes;
+    uint32_t best = work->front;
+    for (uint32_t cur = work->front; cur != ILIST_NIL; cur = N[cur].il_next) {
+        if (comes_before(L, cur, best)) best = cur;
+    }
+    chain_detach(N, work, best);
+    chain_push_back(N, out, best);
+    selection_sort_recur(L, work, out);
+}
+
+/* ----- iterative selection sort (Standish 5.35) ----- */
+static void selection_sort_iterative(ilist_t *L, ichain_t *C)
+{
+    ilist_node_t *N = L->il_nodes;
+    ichain_t out = { ILIST_NIL, ILIST_NIL, 0 };
+    while (C->count > 0) {
+        uint32_t best = C->front;
+        for (uint32_t cur = C->front; cur != ILIST_NIL; cur = N[cur].il_next) {
+            if (comes_before(L, cur, best)) best = cur;
+        }
+        chain_detach(N, C, best);
+        chain_push_back(N, &out, best);
+    }
+    *C = out;
+}
+
+/* ----- merge sort (Standish 6.19) ----- */
+static void mergesort_chain(ilist_t *L, ichain_t *C)
+{
+    if (C->count <= 1) return;
+    ilist_node_t *N = L->il_nodes;
+
+    /* split in half */
+    ichain_t left = { C->front, ILIST_NIL, C->count / 2 };
+    ichain_t right = { ILIST_NIL, C->back, C->count - left.count };
+    uint32_t left_tail = C->front;
+    for (int i = 1; i < left.count; i++) left_tail = N[left_tail].il_next;
+    left.back = left_tail;
+    right.front = N[left_tail].il_next;
+    N[right.front].il_prev = ILIST_NIL;
+    N[left_tail].il_next = ILIST_NIL;
+
+    mergesort_chain(L, &left);
+    mergesort_chain(L, &right);
+
+    ichain_t dst = { ILIST_NIL, ILIST_NIL, 0 };
+    while (left.count > 0 && right.count > 0) {
+        /* take from the right only when strictly first, so ties stay stable */
+        if (comes_before(L, right.front, left.front))
+            chain_push_back(N, &dst, chain_pop_front(N, &right));
+        else
+            chain_push_back(N, &dst, chain_pop_front(N, &left));
+    }
+    while (left.count > 0) chain_push_back(N, &dst, chain_pop_front(N, &left));
+    while (right.count > 0) chain_push_back(N, &dst, chain_pop_front(N, &right));
+    *C = dst;
+}
+
+/* ----- quick sort via qsort_r on an index array ----- */
+static int qsort_compare(const void *p_a, const void *p_b, void *lptr)
+{
+    ilist_t *L = (ilist_t *) lptr;
+    return -L->compare_fun(&L->il_nodes[*(const uint32_t *) p_a].il_data,
+                           &L->il_nodes[*(const uint32_t *) p_b].il_data);
+}
+
+static void quick_sort_array(ilist_t *L, ichain_t *C)
+{
+    int n = C->count;
+    if (n > L->il_sort_arena_cap) {
+        free(L->il_sort_arena);
+        L->il_sort_arena = (uint32_t *) malloc(n * sizeof(uint32_t));
+        assert(L->il_sort_arena);
+        L->il_sort_arena_cap = n;
+    }
+    uint32_t *A = L->il_sort_arena;
+    ilist_node_t *N = L->il_nodes;
+
+    int i = 0;
+    for (uint32_t r = C->front; r != ILIST_NIL; r = N[r].il_next) A[i++] = r;
+    qsort_r(A, n, sizeof(uint32_t), qsort_compare, L);
+
+    for (i = 0; i < n; i++) {
+        N[A[i]].il_prev = (i > 0) ? A[i-1] : ILIST_NIL;
+        N[A[i]].il_next = (i < n-1) ? A[i+1] : ILIST_NIL;
+    }
+    C->front = A[0];
+    C->back = A[n-1];
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
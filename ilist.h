@@ -0,0 +1,58 @@
+/* ilist.h
+ * Index-linked list ADT in a single node arena
+ *
+ * Same operations as llist.h.  Nodes live in one growable array and are
+ * linked by 32-bit indices; each node stores its alert_t inline, so an
+ * element costs 40 bytes with no per-element malloc.
+ *
+ * Ownership follows llist: ilist_insert takes elem_ptr (the record is
+ * copied into the arena and elem_ptr is freed), and ilist_remove returns
+ * a malloc'd record the caller must free.  Pointers from ilist_access and
+ * ilist_elem_find are valid until the next insert.
+ */
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stdint.h>
+#include "datatypes.h"
+#include "llist.h"     /* LLPOSITION_FRONT / LLPOSITION_BACK */
+
+#define ILIST_NIL 0xffffffffu
+
+typedef struct ilist_node_tag {
+    data_t il_data;
+    uint32_t il_prev;
+    uint32_t il_next;   /* also links the free list */
+} ilist_node_t;
+
+typedef struct ilist_header_tag {
+    ilist_node_t *il_nodes;   /* the arena */
+    uint32_t il_cap;
+    uint32_t il_used;         /* slots ever handed out */
+    uint32_t il_free;         /* head of the free-slot list */
+    uint32_t il_front;
+    uint32_t il_back;
+    int il_entry_count;
+    int il_sorted_state;      /* private flag used only by ilist.c */
+    int (*compare_fun)(const data_t *, const data_t *);
+    uint32_t *il_sort_arena;  /* index scratch kept across sorts */
+    int il_sort_arena_cap;
+} ilist_t;
+
+data_t *  ilist_access(ilist_t *list_ptr, int pos_index);
+ilist_t * ilist_construct(int (*fcomp)(const data_t *, const data_t *));
+void      ilist_destruct(ilist_t *list_ptr);
+data_t *  ilist_elem_find(ilist_t *list_ptr, data_t *elem_ptr, int *pos_index,
+                          int (*fcomp)(const data_t *, const data_t *));
+int       ilist_entries(ilist_t *list_ptr);
+void      ilist_insert(ilist_t *list_ptr, data_t *elem_ptr, int pos_index);
+void      ilist_insert_sorted(ilist_t *list_ptr, data_t *elem_ptr);
+data_t *  ilist_remove(ilist_t *list_ptr, int pos_index);
+
+/* sort_type 1-5 as llist_sort (merge sort 4 is stable here); any other
+ * type runs merge sort
+ */
+void      ilist_sort(ilist_t *list_ptr, int sort_type,
+                     int (*fcomp)(const data_t *, const data_t *));
+
+#endif
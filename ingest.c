@@ -0,0 +1,125 @@
+/* ingest.c
+ * ECE 2230 Fall 2025
+ * MP3 — concurrent ingest front end
+ *
+ * Purpose:
+ *   Batched multi-producer, single-consumer queue feeding an llist_t.
+ *   The shared queue is an intrusive MPSC list of batches: a producer
+ *   publishes with an atomic exchange on the tail and then links the old
+ *   tail to its batch, and the consumer walks from the head.  Between
+ *   those two producer steps the chain is briefly broken; the consumer
+ *   simply stops there and picks the batch up on a later drain.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "ingest.h"
+
+/* ===== private helpers ===== */
+static void queue_push(ingest_queue_t *q, ingest_batch_t *b);
+static ingest_batch_t *queue_pop(ingest_queue_t *q);
+
+ingest_queue_t *ingest_construct(void)
+{
+    ingest_queue_t *q = (ingest_queue_t *) malloc(sizeof(ingest_queue_t));
+    assert(q);
+    atomic_init(&q->iq_stub.ib_next, NULL);
+    q->iq_stub.ib_count = 0;
+    q->iq_head = &q->iq_stub;
+    atomic_init(&q->iq_tail, &q->iq_stub);
+    return q;
+}
+
+void ingest_destruct(ingest_queue_t *q)
+{
+    assert(q);
+    /* callers drain the queue first; pop outside assert so -DNDEBUG keeps it */
+    ingest_batch_t *left = queue_pop(q);
+    assert(left == NULL);
+    (void) left;
+    free(q);
+}
+
+void ingest_producer_init(ingest_producer_t *p, ingest_queue_t *q)
+{
+    assert(p && q);
+    p->ip_queue = q;
+    p->ip_batch = NULL;
+}
+
+void ingest_append(ingest_producer_t *p, data_t *rec)
+{
+    assert(p && rec);
+    ingest_batch_t *b = p->ip_batch;
+    if (b == NULL) {
+        b = (ingest_batch_t *) malloc(sizeof(ingest_batch_t));
+        assert(b);
+        b->ib_count = 0;
+        p->ip_batch = b;
+    }
+    b->ib_recs[b->ib_count++] = rec;
+    if (b->ib_count == INGEST_BATCH) ingest_flush(p);
+}
+
+void ingest_flush(ingest_producer_t *p)
+{
+    assert(p);
+    if (p->ip_batch == NULL) return;
+    queue_push(p->ip_queue, p->ip_batch);
+    p->ip_batch = NULL;
+}
+
+int ingest_drain(ingest_queue_t *q, llist_t *list_ptr)
+{
+    assert(q && list_ptr);
+    int moved = 0;
+    ingest_batch_t *b;
+    while ((b = queue_pop(q)) != NULL) {
+        for (int i = 0; i < b->ib_count; i++) llist_insert(list_ptr, b->ib_recs[i], LLPOSITION_BACK);
+        moved += b->ib_count;
+        free(b);
+    }
+    return moved;
+}
+
+/* ===== helpers ===== */
+
+static void queue_push(ingest_queue_t *q, ingest_batch_t *b)
+{
+    atomic_store_explicit(&b->ib_next, NULL, memory_order_relaxed);
+    ingest_batch_t *prev = atomic_exchange_explicit(&q->iq_tail, b, memory_order_acq_rel);
+    /* release: the batch contents are visible before it is reachable */
+    atomic_store_explicit(&prev->ib_next, b, memory_order_release);
+}
+
+/* NULL when the queue is empty or the next batch is still being linked */
+static ingest_batch_t *queue_pop(ingest_queue_t *q)
+{
+    ingest_batch_t *head = q->iq_head;
+    ingest_batch_t *next = atomic_load_explicit(&head->ib_next, memory_order_acquire);
+
+    if (head == &q->iq_stub) {
+        if (next == NULL) return NULL;
+        q->iq_head = next;
+        head = next;
+        next = atomic_load_explicit(&head->ib_next, memory_order_acquire);
+    }
+    if (next) {
+        q->iq_head = next;
+        return head;
+    }
+
+    /* head is the last linked batch: only hand it out once the stub is
+     * queued behind it, so the queue never becomes empty
+     */
+    if (head != atomic_load_explicit(&q->iq_tail, memory_order_acquire)) return NULL;
+    queue_push(q, &q->iq_stub);
+    next = atomic_load_explicit(&head->ib_next, memory_order_acquire);
+    if (next) {
+        q->iq_head = next;
+        return head;
+    }
+    return NULL;
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
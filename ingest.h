@@ -0,0 +1,56 @@
+/* ingest.h
+ * Multi-producer ingest queue in front of the list ADT
+ *
+ * Capture threads append records through their own ingest_producer_t,
+ * which fills a private batch and publishes it to the shared queue with
+ * one atomic exchange (an intrusive MPSC queue, so producers never take a
+ * lock or wait on each other).  A single consumer thread calls
+ * ingest_drain to move published batches onto the back of an llist_t.
+ *
+ * Records from one producer reach the list in the order that producer
+ * appended them; batches from different producers interleave.
+ */
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <stdatomic.h>
+#include "datatypes.h"
+#include "llist.h"
+
+#define INGEST_BATCH 256
+
+typedef struct ingest_batch_tag {
+    struct ingest_batch_tag *_Atomic ib_next;
+    int ib_count;
+    data_t *ib_recs[INGEST_BATCH];
+} ingest_batch_t;
+
+typedef struct ingest_queue_tag {
+    ingest_batch_t *_Atomic iq_tail;   /* producers exchange here */
+    ingest_batch_t *iq_head;           /* consumer only */
+    ingest_batch_t iq_stub;            /* keeps the queue non-empty */
+} ingest_queue_t;
+
+typedef struct ingest_producer_tag {
+    ingest_queue_t *ip_queue;
+    ingest_batch_t *ip_batch;          /* being filled, not yet visible */
+} ingest_producer_t;
+
+ingest_queue_t * ingest_construct(void);
+/* the queue must be drained, and every producer flushed, first */
+void             ingest_destruct(ingest_queue_t *q);
+
+/* one producer per thread; it is not safe to share a producer */
+void             ingest_producer_init(ingest_producer_t *p, ingest_queue_t *q);
+/* takes ownership of rec, as llist_insert does */
+void             ingest_append(ingest_producer_t *p, data_t *rec);
+/* publish a partly filled batch; call before the producer thread exits */
+void             ingest_flush(ingest_producer_t *p);
+
+/* consumer only: append every published record to the back of list_ptr
+ * and return how many were moved.  A batch that is mid-publish is left
+ * for the next call.
+ */
+int              ingest_drain(ingest_queue_t *q, llist_t *list_ptr);
+
+#endif
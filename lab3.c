@@ -5,36 +5,574 @@
  *
  * Minimal driver for MP3 performance testing. Reads commands from stdin.
  * Commands used by geninput/longrun.sh:
- *   - APPENDREAR g d   : append record with generator_id=g, dest_ip=d (no print)
+ *   - APPENDREAR g d [t] : append record with generator_id=g, dest_ip=d and
+ *                        timestamp t (default 0); no print
  *   - SORTGEN t        : sort queue by generator_id ASC using algorithm t=1..5
  *   - SORTIP  t        : sort queue by dest_ip     DESC using algorithm t=1..5
  *   - PRINTQ           : print queue contents (for small N)
+ *   - BENCHALL f [t..] : sort a shallow clone of the queue (llist_clone) by
+ *                        field f (gen or ip) with each listed sort type,
+ *                        default 1..8, printing each one's timing line, then
+ *                        check that every result holds the same keys in
+ *                        the same order.  The queue itself is unchanged.
  *   - QUIT             : free all memory and exit
+ * Background sorts (asort.h):
+ *   - ASORTGEN t       : start sorting a snapshot of the queue by generator_id;
+ *   - ASORTIP  t         later APPENDREARs go to a fresh queue without waiting
+ *   - AWAIT [MERGE]    : wait for the sort and put the snapshot back in front
+ *                        of the new arrivals, or with MERGE sort them in too
+ *   Any other command that reads the queue waits (without MERGE) first.
+ * Snapshots (llist_save / llist_load):
+ *   - SAVE path        : write the queue to a snapshot file
+ *   - LOAD path        : replace the queue with a snapshot file's contents
+ *   - DUMPQ path       : write the queue's records in order as packed
+ *                        data_t, no header (recout.h), for other tools;
+ *                        records/sec goes to stderr
+ * Cold tier (coldtier.h):
+ *   - FREEZE [k]       : compress the first k records (default all) of the
+ *                        queue into the cold tier, behind any already there
+ *   - COLD             : print the cold tier's size against the same
+ *                        records as list nodes
+ *   PRINTQ lists cold records first without decompressing the tier as a
+ *   whole; sorts, SAVE, DUMPQ, BENCHALL and WINDOW thaw it back in front
+ *   of the queue first, and LOAD drops it with the rest of the queue.
+ *   FREEZE is refused while a WINDOW is set.
+ * Retention (retain.h):
+ *   - WINDOW w [g]     : keep alerts for w seconds, expired in g-second
+ *                        buckets (default 1); WINDOW 0 turns it off
+ *   - EXPIRE [now]     : drop alerts older than now - w (default now: the
+ *                        latest timestamp seen) and print how many went
+ * Latency (hdrhist.h, with -H):
+ *   - HIST [RESET]     : print count and p50/p90/p99/p999/max ns per command
+ *                        type, then for line parsing and all dispatch; RESET
+ *                        clears them afterwards.  -H also prints them at QUIT.
  *
  * The ONLY mandatory output for timing is the single line:
  *     "<N>\t<msec>\t<type>\n"
+ * which a background sort prints when it is waited for.
+ *
+ * Options:
+ *   -c                 : keep the queue in the columnar store (colstore.h)
+ *                        instead of the linked list.  Every sort is the
+ *                        store's stable radix sort whatever type is asked
+ *                        for, and its timing line reports type 9
+ *                        (IDS_COLS_SORT_TYPE); equal keys keep queue order,
+ *                        which only sort types 1, 6 and 7 promise
+ *   -p N               : pipelined ingest with N builder threads (pipeline.h);
+ *                        output is unchanged, stage throughput goes to stderr
+ *   -b B               : APPENDREAR lines per pipeline batch (default 4096)
+ *   -H                 : record per-command latency histograms (see HIST)
+ *   -M                 : allocation accounting (memacct.h): after each
+ *                        SORTGEN/SORTIP timing line print the queue's bytes
+ *                        and the peak live bytes during the sort; at QUIT
+ *                        print allocations by call site (not with -c)
+ *   -d                 : dual-order queue (llist_set_dual): SORTGEN after
+ *                        SORTIP, or the reverse, swaps in the order kept
+ *                        from the earlier sort in O(1) when nothing was
+ *                        appended since; equal keys keep that sort's order.
+ *                        Off while a WINDOW is set (not with -c)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
-#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "ids_support.h"   /* includes llist.h / datatypes.h */
+#include "pipeline.h"
+#include "asort.h"
+#include "retain.h"
+#include "hdrhist.h"
+#include "memacct.h"
+#include "coldtier.h"
 
 #define MAXLINE 256
 
 static double ms_now(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (double)tv.tv_sec * 1000.0 + (double)tv.tv_usec / 1000.0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+static long long ns_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* lab3's queue and mode state, shared by the command handlers */
+typedef struct lab3_tag {
+    llist_t *queue;           /* the alert queue; NULL with -c */
+    colstore_t *cols;         /* -c: the queue as columns */
+    pipeline_t *pipe;         /* -p: APPENDREAR batches in flight */
+    asort_t *pending;         /* background sort, after ASORT* */
+    coldtier_t *cold;         /* frozen front of the queue, after FREEZE */
+    retain_t *ret;            /* retention over queue's nodes, after WINDOW */
+    int window;               /* seconds kept; 0 = no WINDOW */
+    int width;                /* expiry bucket, seconds */
+    int dual;                 /* -d */
+    int cols_newest;          /* -c: latest timestamp seen, as retain_newest */
+    int cols_resort;          /* -c: 1 gen / 2 ip after an ASORT*, for AWAIT MERGE */
+    hdrhist_t **hists;        /* -H: per command, then other, parse, dispatch */
+} lab3_t;
+
+/* ===== private helpers ===== */
+static void cmd_append(lab3_t *st, const char *line, int arg);
+static void cmd_sort(lab3_t *st, const char *line, int bygen);
+static void cmd_asort(lab3_t *st, const char *line, int bygen);
+static void cmd_await(lab3_t *st, const char *line, int arg);
+static void cmd_window(lab3_t *st, const char *line, int arg);
+static void cmd_expire(lab3_t *st, const char *line, int arg);
+static void cmd_save(lab3_t *st, const char *line, int arg);
+static void cmd_load(lab3_t *st, const char *line, int arg);
+static void cmd_dump(lab3_t *st, const char *line, int arg);
+static void cmd_print(lab3_t *st, const char *line, int arg);
+static void cmd_bench(lab3_t *st, const char *line, int arg);
+static void cmd_freeze(lab3_t *st, const char *line, int arg);
+static void cmd_cold(lab3_t *st, const char *line, int arg);
+static void cmd_hist(lab3_t *st, const char *line, int arg);
+
+/* Every command but QUIT.  A command's -H histogram has its index; list_only
+ * commands answer "<cmd>: not available with -c" under -c.
+ */
+static const struct command {
+    const char *name;
+    void (*run)(lab3_t *st, const char *line, int arg);
+    int arg;                  /* handed to run: 1 for the gen half of a gen/ip pair */
+    int list_only;
+} commands[] = {
+    { "APPENDREAR", cmd_append, 0, 0 },
+    { "SORTGEN",    cmd_sort,   1, 0 },
+    { "SORTIP",     cmd_sort,   0, 0 },
+    { "ASORTGEN",   cmd_asort,  1, 0 },
+    { "ASORTIP",    cmd_asort,  0, 0 },
+    { "AWAIT",      cmd_await,  0, 0 },
+    { "WINDOW",     cmd_window, 0, 0 },
+    { "EXPIRE",     cmd_expire, 0, 0 },
+    { "SAVE",       cmd_save,   0, 0 },
+    { "LOAD",       cmd_load,   0, 0 },
+    { "DUMPQ",      cmd_dump,   0, 0 },
+    { "PRINTQ",     cmd_print,  0, 0 },
+    { "BENCHALL",   cmd_bench,  0, 1 },
+    { "FREEZE",     cmd_freeze, 0, 1 },
+    { "COLD",       cmd_cold,   0, 1 },
+    { "HIST",       cmd_hist,   0, 0 },
+};
+
+/* -H histograms: one per command, then "other", parse and dispatch */
+#define NCOMMANDS     ((int) (sizeof(commands) / sizeof(commands[0])))
+#define HIST_OTHER    NCOMMANDS
+#define HIST_PARSE    (NCOMMANDS + 1)
+#define HIST_DISPATCH (NCOMMANDS + 2)
+#define HIST_COUNT    (NCOMMANDS + 3)
+
+static void hist_print(hdrhist_t **hists);
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: ./lab3 [-c | -p threads [-b lines]] [-H] [-M] [-d] < commands\n");
+    fprintf(stderr, "\t-c: columnar queue; every sort is a stable radix sort, reported as type %d\n",
+            IDS_COLS_SORT_TYPE);
+    fprintf(stderr, "\t-p: pipelined ingest with this many builder threads\n");
+    fprintf(stderr, "\t-b: APPENDREAR lines per pipeline batch\n");
+    fprintf(stderr, "\t-H: per-command latency histograms, printed by HIST and at QUIT\n");
+    fprintf(stderr, "\t-M: memory accounting after each sort and at QUIT (not with -c)\n");
+    fprintf(stderr, "\t-d: keep gen and ip orders both, switching in O(1) (not with -c)\n");
+    exit(1);
+}
+
+/* the column store has no per-row unlink, so expiry rebuilds it: O(n) */
+static colstore_t *cols_expire(colstore_t *cs, int now, int window, int width, int *expired)
+{
+    colstore_t *keep = colstore_construct();
+    int n = colstore_entries(cs);
+    for (int i = 0; i < n; i++) {
+        alert_t rec;
+        colstore_get(cs, i, &rec);
+        if (!retain_is_expired(rec.timestamp, now, window, width)) colstore_append(keep, &rec);
+    }
+    *expired = n - colstore_entries(keep);
+    colstore_destruct(cs);
+    return keep;
+}
+
+static int cols_newest(colstore_t *cs)
+{
+    int newest = 0;
+    for (int i = 0; i < colstore_entries(cs); i++) {
+        int ts = colstore_get_field(cs, i, COL_TIMESTAMP);
+        if (ts > newest) newest = ts;
+    }
+    return newest;
+}
+
+/* -M: the line printed under a sort's timing line */
+static void print_sort_memory(llist_t *queue, long long before)
+{
+    int n = llist_entries(queue);
+    size_t bytes = llist_bytes(queue);
+    printf("Memory: queue %zu bytes, %.1f per record; sort peak %lld bytes live (+%lld)\n",
+           bytes, n > 0 ? (double) bytes / n : 0.0, memacct_mark_peak(), memacct_mark_peak() - before);
+    fflush(stdout);
+}
+
+/* the mandatory "<N>\t<msec>\t<type>" line */
+static void print_timing(int n, double msec, int type)
+{
+    printf("%d\t%.6f\t%d\n", n, msec, type);
+    fflush(stdout);
+}
+
+/* wait for a background sort, publish it and print its timing line */
+static asort_t *await_sort(asort_t *pending, llist_t *queue, int merge)
+{
+    if (pending == NULL) return NULL;
+    int t = asort_type(pending);
+    int n;
+    double msec;
+    asort_finish(pending, queue, merge, &n, &msec);
+    if (merge) n = llist_entries(queue);
+    print_timing(n, msec, t);
+    return NULL;
+}
+
+/* put frozen records back in front of the queue for a command that needs
+ * them as nodes
+ */
+static void thaw_queue(coldtier_t *cold, llist_t *queue)
+{
+    if (cold && coldtier_entries(cold) > 0) coldtier_thaw(cold, queue);
+}
+
+/* before a command that reads the queue: drain the pipeline and wait for
+ * a background sort
+ */
+static void settle(lab3_t *st)
+{
+    if (st->pipe) pipeline_sync(st->pipe, NULL, 0, NULL);
+    st->pending = await_sort(st->pending, st->queue, 0);
+    st->cols_resort = 0;
+}
+
+static void cols_sort(colstore_t *cs, int bygen)
+{
+    if (bygen) ids_cols_sort_gen(cs);
+    else       ids_cols_sort_ip(cs);
+}
+
+/* ===== commands: run(st, line, arg) ===== */
+
+static void cmd_append(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    /* retention tracks each node as it is appended, so bypass the pipeline */
+    if (st->pipe && !st->ret) {
+        pipeline_append_line(st->pipe, line);
+        return;
+    }
+    int gen, ip, ts = 0;
+    if (sscanf(line, "%*s %d %d %d", &gen, &ip, &ts) < 2) return;
+    if (st->cols) {
+        ids_cols_append_rear_ts(st->cols, gen, ip, ts);
+        if (ts > st->cols_newest) st->cols_newest = ts;
+    } else {
+        ids_append_rear_ts(st->queue, gen, ip, ts);
+        if (st->ret) retain_track(st->ret, st->queue->ll_back);
+    }
+}
+
+/* SORTGEN (bygen) / SORTIP */
+static void cmd_sort(lab3_t *st, const char *line, int bygen)
+{
+    int t;
+    if (sscanf(line, "%*s %d", &t) != 1) return;
+    /* stable types are pre-sorted per shard and merged */
+    int presort = st->pipe && (t == 6 || t == 7);
+    if (st->pipe && !presort) pipeline_sync(st->pipe, NULL, 0, NULL);
+    st->pending = await_sort(st->pending, st->queue, 0);
+    thaw_queue(st->cold, st->queue);
+    st->cols_resort = 0;
+    long long mem0 = memacct_enabled() ? memacct_mark() : 0;
+    double t0 = ms_now();
+    if (presort)
+        pipeline_sync(st->pipe, bygen ? ids_sort_gen : ids_sort_ip, t,
+                      bygen ? ids_compare_genid : ids_compare_destip);
+    else if (st->cols)
+        cols_sort(st->cols, bygen);
+    else if (bygen)
+        ids_sort_gen(st->queue, t);
+    else
+        ids_sort_ip(st->queue, t);
+    double t1 = ms_now();
+    if (st->cols) print_timing(colstore_entries(st->cols), t1 - t0, IDS_COLS_SORT_TYPE);
+    else          print_timing(llist_entries(st->queue), t1 - t0, t);
+    if (memacct_enabled()) print_sort_memory(st->queue, mem0);
+}
+
+/* ASORTGEN (bygen) / ASORTIP */
+static void cmd_asort(lab3_t *st, const char *line, int bygen)
+{
+    int t;
+    if (sscanf(line, "%*s %d", &t) != 1) return;
+    if (st->cols) {
+        /* the columnar store sorts in place; run it now */
+        int N = colstore_entries(st->cols);
+        double t0 = ms_now();
+        cols_sort(st->cols, bygen);
+        double t1 = ms_now();
+        print_timing(N, t1 - t0, IDS_COLS_SORT_TYPE);
+        st->cols_resort = bygen ? 1 : 2;
+        return;
+    }
+    if (st->pipe) pipeline_sync(st->pipe, NULL, 0, NULL);
+    st->pending = await_sort(st->pending, st->queue, 0);
+    thaw_queue(st->cold, st->queue);
+    st->pending = asort_start(st->queue, bygen ? ids_sort_gen : ids_sort_ip, t);
+}
+
+static void cmd_await(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    char how[16] = {0};
+    int merge = (sscanf(line, "%*s %15s", how) == 1 && strcmp(how, "MERGE") == 0);
+    if (st->pipe) pipeline_sync(st->pipe, NULL, 0, NULL);
+    st->pending = await_sort(st->pending, st->queue, merge);
+    /* column sorts are stable, so a full re-sort equals the merge */
+    if (st->cols && merge && st->cols_resort) cols_sort(st->cols, st->cols_resort == 1);
+    st->cols_resort = 0;
+}
+
+static void cmd_window(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    int w, g = 1;
+    if (sscanf(line, "%*s %d %d", &w, &g) < 1 || g <= 0) return;
+    settle(st);
+    thaw_queue(st->cold, st->queue);
+    if (st->ret) retain_destruct(st->ret);
+    st->ret = NULL;
+    st->window = w > 0 ? w : 0;
+    st->width = g;
+    /* retention holds node pointers, which a dual sort may swap */
+    if (st->dual) llist_set_dual(st->queue, st->window == 0);
+    if (st->window && st->cols) {
+        st->cols_newest = cols_newest(st->cols);
+    } else if (st->window) {
+        st->ret = retain_construct(st->window, st->width);
+        retain_track_list(st->ret, st->queue);
+    }
+}
+
+static void cmd_expire(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    settle(st);
+    if (st->window == 0) {
+        printf("EXPIRE: no WINDOW set\n");
+        return;
+    }
+    int now = st->cols ? st->cols_newest : retain_newest(st->ret);
+    int expired;
+    sscanf(line, "%*s %d", &now);
+    if (st->cols) st->cols = cols_expire(st->cols, now, st->window, st->width, &expired);
+    else          expired = retain_expire(st->ret, st->queue, now);
+    printf("Expired %d records\n", expired);
+}
+
+static void cmd_save(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    char path[MAXLINE];
+    if (sscanf(line, "%*s %255s", path) != 1) return;
+    settle(st);
+    thaw_queue(st->cold, st->queue);
+    llist_t *L = st->queue;
+    if (st->cols) {
+        L = llist_construct(NULL);
+        colstore_to_llist(st->cols, L);
+    }
+    if (llist_save(L, path) != 0) printf("SAVE failed: %s\n", path);
+    if (st->cols) llist_destruct(L);
+}
+
+static void cmd_load(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    char path[MAXLINE];
+    if (sscanf(line, "%*s %255s", path) != 1) return;
+    settle(st);
+    llist_t *L = llist_load(path);
+    if (L == NULL) {
+        printf("LOAD failed: %s\n", path);
+        return;
+    }
+    if (st->cols) {
+        colstore_destruct(st->cols);
+        st->cols = colstore_from_llist(L);
+        llist_destruct(L);
+        st->cols_newest = cols_newest(st->cols);
+        return;
+    }
+    /* keep the queue header; the pipeline points at it */
+    llist_t *old = llist_construct(NULL);
+    llist_splice(old, st->queue);
+    llist_destruct(old);
+    llist_splice(st->queue, L);
+    llist_destruct(L);
+    if (st->cold) coldtier_destruct(st->cold);
+    st->cold = NULL;
+    if (st->ret) {
+        /* every node is new */
+        retain_destruct(st->ret);
+        st->ret = retain_construct(st->window, st->width);
+        retain_track_list(st->ret, st->queue);
+    }
+}
+
+static void cmd_dump(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    char path[MAXLINE];
+    if (sscanf(line, "%*s %255s", path) != 1) return;
+    settle(st);
+    thaw_queue(st->cold, st->queue);
+    double t0 = ms_now();
+    int n = st->cols ? ids_cols_dump(st->cols, path) : ids_dump(st->queue, path);
+    double t1 = ms_now();
+    if (n < 0) {
+        printf("DUMPQ failed: %s\n", path);
+    } else {
+        fprintf(stderr, "DUMPQ: %d records in %.3f ms (%.0f records/s)\n",
+                n, t1 - t0, t1 > t0 ? n / ((t1 - t0) / 1000.0) : 0.0);
+    }
+}
+
+static void cmd_print(lab3_t *st, const char *line, int arg)
+{
+    (void) line;
+    (void) arg;
+    settle(st);
+    if (st->cols) ids_cols_print(st->cols, "Queue");
+    else          ids_cold_print(st->cold, st->queue, "Queue");
 }
 
-int main(void)
+static void cmd_bench(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    char field[16] = {0};
+    int off = 0;
+    if (sscanf(line, "%*s %15s%n", field, &off) != 1) return;
+    if (strcmp(field, "gen") != 0 && strcmp(field, "ip") != 0) return;
+    int types[8], ntypes = 0, t, used;
+    const char *p = line + off;
+    while (ntypes < 8 && sscanf(p, "%d%n", &t, &used) == 1) {
+        if (t >= 1 && t <= 8) types[ntypes++] = t;
+        p += used;
+    }
+    if (ntypes == 0)
+        for (t = 1; t <= 8; t++) types[ntypes++] = t;
+    settle(st);
+    thaw_queue(st->cold, st->queue);
+    ids_bench_all(st->queue, strcmp(field, "gen") == 0, types, ntypes);
+}
+
+static void cmd_freeze(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    long k = -1;
+    sscanf(line, "%*s %ld", &k);
+    if (st->window) {
+        /* retention holds pointers to the nodes FREEZE would free */
+        printf("FREEZE: not available while a WINDOW is set\n");
+        return;
+    }
+    settle(st);
+    if (st->cold == NULL) st->cold = coldtier_construct();
+    printf("Froze %ld records\n", coldtier_freeze(st->cold, st->queue, k));
+}
+
+static void cmd_cold(lab3_t *st, const char *line, int arg)
+{
+    (void) line;
+    (void) arg;
+    ids_cold_stats(st->cold);
+}
+
+static void cmd_hist(lab3_t *st, const char *line, int arg)
+{
+    (void) arg;
+    char how[16] = {0};
+    if (st->hists == NULL) {
+        printf("HIST: no histograms (run lab3 with -H)\n");
+        return;
+    }
+    hist_print(st->hists);
+    if (sscanf(line, "%*s %15s", how) == 1 && strcmp(how, "RESET") == 0)
+        for (int i = 0; i < HIST_COUNT; i++) hdrhist_reset(st->hists[i]);
+}
+
+/* ===== dispatch ===== */
+
+static int find_command(const char *cmd)
+{
+    for (int i = 0; i < NCOMMANDS; i++)
+        if (strcmp(cmd, commands[i].name) == 0) return i;
+    return HIST_OTHER;
+}
+
+static void hist_print(hdrhist_t **hists)
+{
+    static const char *extra[] = { "other", "parse", "dispatch" };
+    static const double pcts[] = { 50, 90, 99, 99.9, 100 };
+    printf("Latency (ns)\tcount\tp50\tp90\tp99\tp999\tmax\n");
+    for (int i = 0; i < HIST_COUNT; i++) {
+        if (hists[i]->count == 0) continue;
+        printf("%s\t%ld", i < NCOMMANDS ? commands[i].name : extra[i - NCOMMANDS], hists[i]->count);
+        for (int p = 0; p < 5; p++) printf("\t%lld", hdrhist_percentile(hists[i], pcts[p]));
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
 {
     char line[MAXLINE];
-    llist_t *queue = ids_create("Queue");
+    int columnar = 0;
+    int builders = 0;
+    int batch_lines = PIPELINE_BATCH_LINES;
+    hdrhist_t *hists[HIST_COUNT] = {NULL};
+    int histograms = 0;
+    int opt;
+    lab3_t st = {0};
+    st.width = 1;
+
+    while ((opt = getopt(argc, argv, "cp:b:HMd")) != -1) {
+        switch (opt) {
+            case 'c': columnar = 1; break;
+            case 'H': histograms = 1; break;
+            case 'M': memacct_enable(); break;
+            case 'd': st.dual = 1; break;
+            case 'p': builders = atoi(optarg); if (builders < 1) usage(); break;
+            case 'b': batch_lines = atoi(optarg); if (batch_lines < 1) usage(); break;
+            default:  usage();
+        }
+    }
+    if (columnar && (builders || memacct_enabled() || st.dual)) usage();
+    if (histograms) {
+        for (int i = 0; i < HIST_COUNT; i++) hists[i] = hdrhist_construct();
+        st.hists = hists;
+    }
+
+    if (columnar) {
+        st.cols = colstore_construct();
+    } else {
+        st.queue = ids_create("Queue");
+        if (st.dual) llist_set_dual(st.queue, 1);
+    }
+    if (builders) st.pipe = pipeline_construct(st.queue, builders, batch_lines);
 
     while (fgets(line, MAXLINE, stdin) != NULL) {
 
@@ -42,50 +580,42 @@ int main(void)
         if (line[0] == '\n' || line[0] == '#') continue;
 
         /* parse first token */
+        long long t_parse = histograms ? ns_now() : 0;
         char cmd[64] = {0};
         if (sscanf(line, "%63s", cmd) != 1) continue;
+        int which = find_command(cmd);
+        long long t_dispatch = histograms ? ns_now() : 0;
+        if (histograms) hdrhist_record(hists[HIST_PARSE], t_dispatch - t_parse);
+        if (strcmp(cmd, "QUIT") == 0) break;
 
-        if (strcmp(cmd, "APPENDREAR") == 0) {
-            int gen, ip;
-            if (sscanf(line, "%*s %d %d", &gen, &ip) == 2) {
-                ids_append_rear_fast(queue, gen, ip);
-            }
-
-        } else if (strcmp(cmd, "SORTGEN") == 0) {
-            int t;
-            if (sscanf(line, "%*s %d", &t) == 1) {
-                int N = llist_entries(queue);
-                double t0 = ms_now();
-                ids_sort_gen(queue, t);
-                double t1 = ms_now();
-                printf("%d\t%.6f\t%d\n", N, t1 - t0, t);
-                fflush(stdout);
-            }
-
-        } else if (strcmp(cmd, "SORTIP") == 0) {
-            int t;
-            if (sscanf(line, "%*s %d", &t) == 1) {
-                int N = llist_entries(queue);
-                double t0 = ms_now();
-                ids_sort_ip(queue, t);
-                double t1 = ms_now();
-                printf("%d\t%.6f\t%d\n", N, t1 - t0, t);
-                fflush(stdout);
-            }
-
-        } else if (strcmp(cmd, "PRINTQ") == 0) {
-            ids_print(queue, "Queue");
-
-        } else if (strcmp(cmd, "QUIT") == 0) {
-            ids_cleanup(queue);
-            return 0;
-
-        } else {
+        if (which == HIST_OTHER) {
             /* silently ignore any other commands */
+        } else if (st.cols && commands[which].list_only) {
+            printf("%s: not available with -c\n", cmd);
+        } else {
+            commands[which].run(&st, line, commands[which].arg);
+        }
+
+        if (histograms) {
+            long long ns = ns_now() - t_dispatch;
+            hdrhist_record(hists[which], ns);
+            hdrhist_record(hists[HIST_DISPATCH], ns);
         }
     }
 
-    /* If input ends without QUIT, still clean up for valgrind hygiene. */
-    ids_cleanup(queue);
+    /* QUIT or end of input: clean up for valgrind hygiene. */
+    if (st.pipe) pipeline_destruct(st.pipe);
+    st.pending = await_sort(st.pending, st.queue, 0);
+    if (st.ret) retain_destruct(st.ret);
+    if (st.cold) coldtier_destruct(st.cold);
+    if (st.cols) colstore_destruct(st.cols);
+    else         ids_cleanup(st.queue);
+    if (histograms) {
+        hist_print(hists);
+        for (int i = 0; i < HIST_COUNT; i++) hdrhist_destruct(hists[i]);
+    }
+    /* after cleanup, so any live bytes left here are a leak */
+    if (memacct_enabled()) memacct_print(stdout);
     return 0;
 }
+
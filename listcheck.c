@@ -0,0 +1,480 @@
+/* listcheck.c
+ * ECE 2230 Fall 2025
+ * MP3 — checked driver for the alternative list backends
+ *
+ * Purpose:
+ *   Runs one random sequence of list operations against a backend and a
+ *   plain llist side by side: positional insert and remove (front, back
+ *   and middle), sorted insert, access, find and sort.  Every returned
+ *   record is compared, and after each step the backend's whole contents
+ *   and its own structure are checked.  The list grows to MAX_ENTRIES and
+ *   drains back to empty over and over, so inserts and removes land on
+ *   every block boundary and reuse every free arena slot.
+ *
+ *   The heap backend is llist itself built with llist_construct_heap.
+ *   Most of its inserts are sorted inserts, so the list keeps moving into
+ *   the binary heap and back out to the node chain whenever a remove,
+ *   access, find or sort needs the chain.  Its contents are read from the
+ *   heap array without linking it, so checking does not change the mode.
+ *
+ *   A sort must leave the backend sorted under the comparator with the
+ *   reference's records; a stable one must match llist_sort type 6
+ *   exactly.  After an unstable sort the reference takes the backend's
+ *   order for equal keys so the two can keep going in step.
+ *
+ *   Prints one line of operation counts when the backend agrees, or the
+ *   first step that differs, and exits 1.
+ *
+ * Usage:
+ *     ./listcheck ullist|ilist|heap [steps] [seed]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "llist.h"
+#include "ullist.h"
+#include "ilist.h"
+#include "ids_support.h"
+
+#define DEFAULT_STEPS  20000
+#define DEFAULT_SEED   2230
+#define MAX_ENTRIES    400
+
+typedef int (*compare_t)(const data_t *, const data_t *);
+
+/* the comparator a sort switches the list to */
+static const compare_t comps[2] = { ids_compare_genid, ids_compare_destip };
+
+/* a backend under test, wrapped to one shape.  insert and insert_sorted
+ * take the record; remove returns one the caller frees.
+ */
+struct backend {
+    const char *name;
+    const char *grew;               /* summary wording for measure rising */
+    const char *shrank;             /* and falling */
+    compare_t initial;              /* comparator construct sorts by, or NULL */
+    int sorted_share;               /* percent of inserts made sorted when allowed */
+    void *   (*construct)(void);
+    void     (*destruct)(void *L);
+    void     (*insert)(void *L, data_t *rec, int pos_index);
+    void     (*insert_sorted)(void *L, data_t *rec);
+    data_t * (*remove)(void *L, int pos_index);
+    data_t * (*access)(void *L, int pos_index);
+    data_t * (*find)(void *L, data_t *key, int *pos_index, compare_t fcomp);
+    void     (*sort)(void *L, int sort_type, compare_t fcomp);
+    int      (*stable)(int sort_type);
+    /* copy the records out in order, checking the backend's structure */
+    int      (*records)(void *L, data_t *out);
+    int      (*measure)(void *L);
+};
+
+/* counts printed in the summary line */
+struct tally {
+    long inserts, removes, sorted_inserts, accesses, finds;
+    long sorts[9];          /* by sort type 1-8 */
+    long grew, shrank;      /* steps that raised or lowered measure */
+    int max_entries;
+};
+
+static const char *backend;
+static long step;
+static const char *op;
+static long serial;
+
+/* ===== private helpers ===== */
+static int run_check(const struct backend *B, long steps);
+static void fail(const char *what);
+static data_t make_record(void);
+static data_t *copy_record(const data_t *rec);
+static int pick_position(int n, int inclusive);
+static int llist_records(llist_t *L, data_t *out);
+static void same_record(const data_t *got, const data_t *want);
+static void same_contents(const data_t *got, int n, const data_t *want, int m);
+static llist_t *check_sort(llist_t *ref, const data_t *got, int n, compare_t fcomp, int stable);
+static int compare_serial(const void *a, const void *b);
+static void print_tally(const struct tally *t, const struct backend *B);
+
+/* ===== unrolled list ===== */
+
+static void *ul_construct(void) { return ullist_construct(NULL); }
+static void ul_destruct(void *L) { ullist_destruct(L); }
+static void ul_insert(void *L, data_t *rec, int pos_index) { ullist_insert(L, rec, pos_index); }
+static void ul_insert_sorted(void *L, data_t *rec) { ullist_insert_sorted(L, rec); }
+static data_t *ul_remove(void *L, int pos_index) { return ullist_remove(L, pos_index); }
+static data_t *ul_access(void *L, int pos_index) { return ullist_access(L, pos_index); }
+static data_t *ul_find(void *L, data_t *key, int *pos_index, compare_t fcomp)
+{
+    return ullist_elem_find(L, key, pos_index, fcomp);
+}
+static void ul_sort(void *L, int sort_type, compare_t fcomp) { ullist_sort(L, sort_type, fcomp); }
+/* every type runs the same stable block merge */
+static int ul_stable(int sort_type) { (void) sort_type; return 1; }
+static int ul_measure(void *L) { return ((ullist_t *) L)->ul_block_count; }
+
+/* checks links, counts, and that no block is empty or over capacity */
+static int ul_records(void *list_ptr, data_t *out)
+{
+    ullist_t *L = (ullist_t *) list_ptr;
+    int n = 0, blocks = 0;
+    ullist_block_t *prev = NULL;
+    for (ullist_block_t *blk = L->ul_front; blk; prev = blk, blk = blk->ul_next) {
+        if (blk->ul_prev != prev) fail("block prev link is wrong");
+        if (blk->ul_count < 1 || blk->ul_count > ULLIST_BLOCK_CAP) fail("block count out of range");
+        for (int i = 0; i < blk->ul_count; i++) out[n++] = *blk->ul_data[i];
+        blocks++;
+    }
+    if (L->ul_back != prev) fail("back block is wrong");
+    if (n != L->ul_entry_count) fail("entry count is wrong");
+    if (blocks != L->ul_block_count) fail("block count is wrong");
+    return n;
+}
+
+static const struct backend ullist_backend = {
+    "ullist", "blocks grew", "shrank", NULL, 0, ul_construct, ul_destruct, ul_insert,
+    ul_insert_sorted, ul_remove, ul_access, ul_find, ul_sort, ul_stable, ul_records, ul_measure,
+};
+
+/* ===== index-linked arena list ===== */
+
+static void *il_construct(void) { return ilist_construct(NULL); }
+static void il_destruct(void *L) { ilist_destruct(L); }
+static void il_insert(void *L, data_t *rec, int pos_index) { ilist_insert(L, rec, pos_index); }
+static void il_insert_sorted(void *L, data_t *rec) { ilist_insert_sorted(L, rec); }
+static data_t *il_remove(void *L, int pos_index) { return ilist_remove(L, pos_index); }
+static data_t *il_access(void *L, int pos_index) { return ilist_access(L, pos_index); }
+static data_t *il_find(void *L, data_t *key, int *pos_index, compare_t fcomp)
+{
+    return ilist_elem_find(L, key, pos_index, fcomp);
+}
+static void il_sort(void *L, int sort_type, compare_t fcomp) { ilist_sort(L, sort_type, fcomp); }
+/* insertion and merge sort keep equal keys in order; selection and qsort need not */
+static int il_stable(int sort_type) { return sort_type == 1 || sort_type == 4 || sort_type > 5; }
+/* slots on the free list */
+static int il_measure(void *L) { return (int) ((ilist_t *) L)->il_used - ((ilist_t *) L)->il_entry_count; }
+
+/* checks both links of every node, the back index, the count, and that
+ * the free list holds exactly the slots the chain does not
+ */
+static int il_records(void *list_ptr, data_t *out)
+{
+    ilist_t *L = (ilist_t *) list_ptr;
+    ilist_node_t *N = L->il_nodes;
+    char *seen = (char *) calloc(L->il_used + 1, 1);
+    int n = 0;
+    uint32_t prev = ILIST_NIL;
+    for (uint32_t r = L->il_front; r != ILIST_NIL; prev = r, r = N[r].il_next) {
+        if (r >= L->il_used || seen[r]) fail("chain leaves the arena or loops");
+        if (N[r].il_prev != prev) fail("node prev link is wrong");
+        seen[r] = 1;
+        out[n++] = N[r].il_data;
+    }
+    if (L->il_back != prev) fail("back index is wrong");
+    if (n != L->il_entry_count) fail("entry count is wrong");
+    int nfree = 0;
+    for (uint32_t r = L->il_free; r != ILIST_NIL; r = N[r].il_next, nfree++)
+        if (r >= L->il_used || seen[r]) fail("free list reaches a live or invalid slot");
+    if (n + nfree != (int) L->il_used) fail("slots lost from both chain and free list");
+    free(seen);
+    return n;
+}
+
+static const struct backend ilist_backend = {
+    "ilist", "free slots grew", "shrank", NULL, 0, il_construct, il_destruct, il_insert,
+    il_insert_sorted, il_remove, il_access, il_find, il_sort, il_stable, il_records, il_measure,
+};
+
+/* ===== llist heap mode ===== */
+
+static void *hp_construct(void) { return llist_construct_heap(ids_compare_genid); }
+static void hp_destruct(void *L) { llist_destruct(L); }
+static void hp_insert(void *L, data_t *rec, int pos_index) { llist_insert(L, rec, pos_index); }
+static void hp_insert_sorted(void *L, data_t *rec) { llist_insert_sorted(L, rec); }
+static data_t *hp_remove(void *L, int pos_index) { return llist_remove(L, pos_index); }
+static data_t *hp_access(void *L, int pos_index) { return llist_access(L, pos_index); }
+static data_t *hp_find(void *L, data_t *key, int *pos_index, compare_t fcomp)
+{
+    return llist_elem_find(L, key, pos_index, fcomp);
+}
+static void hp_sort(void *L, int sort_type, compare_t fcomp) { llist_sort(L, sort_type, fcomp); }
+/* insertion and the array merge keep equal keys in order; list merge sort
+ * hands ties to the right half
+ */
+static int hp_stable(int sort_type) { return sort_type == 1 || sort_type == 6 || sort_type == 7; }
+static int hp_measure(void *L) { return ((llist_t *) L)->ll_heap_count > 0; }
+
+static llist_t *heap_list;   /* for compare_heap_entry */
+
+/* pop order: fcomp first, then insertion sequence */
+static int compare_heap_entry(const void *a, const void *b)
+{
+    const llist_heap_entry_t *x = (const llist_heap_entry_t *) a;
+    const llist_heap_entry_t *y = (const llist_heap_entry_t *) b;
+    int c = heap_list->compare_fun(x->data_ptr, y->data_ptr);
+    if (c != 0) return c > 0 ? -1 : 1;
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+/* in heap mode: the chain must be empty and every entry no earlier than
+ * its parent; the contents are the entries in pop order.  Otherwise the
+ * node chain, checking both links.
+ */
+static int hp_records(void *list_ptr, data_t *out)
+{
+    llist_t *L = (llist_t *) list_ptr;
+    int n = L->ll_heap_count;
+    if (n > 0) {
+        if (L->ll_front || L->ll_back) fail("node chain is not empty in heap mode");
+        if (n != L->ll_entry_count) fail("entry count is wrong");
+        llist_heap_entry_t *H = (llist_heap_entry_t *) malloc(n * sizeof(llist_heap_entry_t));
+        memcpy(H, L->ll_heap, n * sizeof(llist_heap_entry_t));
+        heap_list = L;
+        for (int i = 1; i < n; i++)
+            if (compare_heap_entry(&H[i], &H[(i - 1) / 2]) < 0) fail("heap order is broken");
+        qsort(H, n, sizeof(llist_heap_entry_t), compare_heap_entry);
+        for (int i = 0; i < n; i++) out[i] = *H[i].data_ptr;
+        free(H);
+        return n;
+    }
+    n = 0;
+    llist_elem_t *prev = NULL;
+    for (llist_elem_t *r = L->ll_front; r; prev = r, r = r->ll_next) {
+        if (r->ll_prev != prev) fail("node prev link is wrong");
+        out[n++] = *r->data_ptr;
+    }
+    if (L->ll_back != prev) fail("back node is wrong");
+    if (n != L->ll_entry_count) fail("entry count is wrong");
+    return n;
+}
+
+static const struct backend heap_backend = {
+    "heap", "entered heap mode", "left it", ids_compare_genid, 90, hp_construct, hp_destruct,
+    hp_insert, hp_insert_sorted, hp_remove, hp_access, hp_find, hp_sort, hp_stable, hp_records,
+    hp_measure,
+};
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 4) {
+        fprintf(stderr, "Usage: ./listcheck ullist|ilist|heap [steps] [seed]\n");
+        exit(1);
+    }
+    long steps = argc > 2 ? atol(argv[2]) : DEFAULT_STEPS;
+    long seed = argc > 3 ? atol(argv[3]) : DEFAULT_SEED;
+    srand48(seed);
+    backend = argv[1];
+
+    if (strcmp(backend, "ullist") == 0) return run_check(&ullist_backend, steps);
+    if (strcmp(backend, "ilist") == 0)  return run_check(&ilist_backend, steps);
+    if (strcmp(backend, "heap") == 0)   return run_check(&heap_backend, steps);
+    fprintf(stderr, "listcheck: unknown backend %s\n", backend);
+    return 1;
+}
+
+static int run_check(const struct backend *B, long steps)
+{
+    void *L = B->construct();
+    llist_t *ref = llist_construct(B->initial);
+    data_t *got = (data_t *) malloc((MAX_ENTRIES + 1) * sizeof(data_t));
+    data_t *want = (data_t *) malloc((MAX_ENTRIES + 1) * sizeof(data_t));
+    struct tally t = {0};
+    int sorted = (B->initial != NULL), growing = 1;
+    int n = 0;
+
+    for (step = 1; step <= steps; step++) {
+        int before = B->measure(L);
+        if (n >= MAX_ENTRIES) growing = 0;
+        if (n == 0) growing = 1;
+        int r = (int) (lrand48() % 100);
+        int grow = growing ? 45 : 15;
+
+        if (r < grow && n < MAX_ENTRIES && sorted && B->sorted_share > 0 &&
+            lrand48() % 100 < B->sorted_share) {
+            r = 60;   /* take the sorted insert below */
+        }
+
+        if (r < grow && n < MAX_ENTRIES) {
+            op = "insert";
+            int pos = pick_position(n, 1);
+            data_t rec = make_record();
+            B->insert(L, copy_record(&rec), pos);
+            llist_insert(ref, copy_record(&rec), pos);
+            sorted = 0;
+            t.inserts++;
+        } else if (r < 60) {
+            op = "remove";
+            int pos = pick_position(n, 0);
+            data_t *a = B->remove(L, pos);
+            data_t *b = llist_remove(ref, pos);
+            if ((a == NULL) != (b == NULL)) fail("one list returned no record");
+            if (a) same_record(a, b);
+            free(a);
+            free(b);
+            t.removes++;
+        } else if (r < 72 && sorted && n < MAX_ENTRIES) {
+            op = "sorted insert";
+            data_t rec = make_record();
+            B->insert_sorted(L, copy_record(&rec));
+            llist_insert_sorted(ref, copy_record(&rec));
+            t.sorted_inserts++;
+        } else if (r < 82) {
+            op = "access";
+            int pos = pick_position(n, 0);
+            data_t *a = B->access(L, pos);
+            data_t *b = llist_access(ref, pos);
+            if ((a == NULL) != (b == NULL)) fail("one list returned no record");
+            if (a) same_record(a, b);
+            t.accesses++;
+        } else if (r < 92) {
+            op = "find";
+            data_t key = make_record();
+            int pa, pb;
+            data_t *a = B->find(L, &key, &pa, ids_match_destip);
+            data_t *b = llist_elem_find(ref, &key, &pb, ids_match_destip);
+            if (pa != pb) fail("positions differ");
+            if ((a == NULL) != (b == NULL)) fail("one list returned no record");
+            if (a) same_record(a, b);
+            t.finds++;
+        } else {
+            op = "sort";
+            int type = 1 + (int) (lrand48() % 8);
+            compare_t fcomp = comps[lrand48() % 2];
+            B->sort(L, type, fcomp);
+            n = B->records(L, got);
+            ref = check_sort(ref, got, n, fcomp, B->stable(type));
+            sorted = 1;
+            t.sorts[type]++;
+        }
+
+        n = B->records(L, got);
+        same_contents(got, n, want, llist_records(ref, want));
+        if (B->measure(L) > before) t.grew++;
+        if (B->measure(L) < before) t.shrank++;
+        if (n > t.max_entries) t.max_entries = n;
+    }
+
+    print_tally(&t, B);
+    B->destruct(L);
+    llist_destruct(ref);
+    free(got);
+    free(want);
+    return 0;
+}
+
+/* ===== helpers ===== */
+
+static void fail(const char *what)
+{
+    printf("%s: step %ld (%s): %s\n", backend, step, op, what);
+    exit(1);
+}
+
+/* few distinct keys, so sorts and sorted inserts meet many ties; the
+ * timestamp is a serial number that tells equal-keyed records apart
+ */
+static data_t make_record(void)
+{
+    data_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.generator_id = 1 + (int) (lrand48() % 8);
+    rec.dest_ip_addr = (int) (lrand48() % 16);
+    rec.timestamp = (int) serial++;
+    return rec;
+}
+
+static data_t *copy_record(const data_t *rec)
+{
+    data_t *p = (data_t *) malloc(sizeof(data_t));
+    assert(p);
+    *p = *rec;
+    return p;
+}
+
+/* LLPOSITION_FRONT, LLPOSITION_BACK or an index below n (up to n when
+ * inclusive, for inserts)
+ */
+static int pick_position(int n, int inclusive)
+{
+    int r = (int) (lrand48() % 8);
+    if (r == 0) return LLPOSITION_FRONT;
+    if (r == 1) return LLPOSITION_BACK;
+    int span = n + (inclusive ? 1 : 0);
+    return span > 0 ? (int) (lrand48() % span) : 0;
+}
+
+static int llist_records(llist_t *L, data_t *out)
+{
+    int n = 0;
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) out[n++] = *r->data_ptr;
+    if (n != llist_entries(L)) fail("reference entry count is wrong");
+    return n;
+}
+
+static void same_record(const data_t *got, const data_t *want)
+{
+    if (memcmp(got, want, sizeof(data_t)) != 0) fail("records differ");
+}
+
+static void same_contents(const data_t *got, int n, const data_t *want, int m)
+{
+    if (n != m) fail("entry counts differ");
+    for (int i = 0; i < n; i++)
+        if (memcmp(&got[i], &want[i], sizeof(data_t)) != 0) fail("contents differ");
+}
+
+/* sort the reference with stable type 6 and check the backend's sorted
+ * records against it; returns the reference, rebuilt in the backend's
+ * order when an unstable sort put equal keys differently
+ */
+static llist_t *check_sort(llist_t *ref, const data_t *got, int n, compare_t fcomp, int stable)
+{
+    data_t *want = (data_t *) malloc((n + 1) * sizeof(data_t));
+    llist_sort(ref, 6, fcomp);
+    if (llist_records(ref, want) != n) fail("entry counts differ");
+
+    for (int i = 0; i + 1 < n; i++)
+        if (fcomp(&got[i+1], &got[i]) == 1) fail("result is not sorted");
+    for (int i = 0; i < n; i++)
+        if (fcomp(&got[i], &want[i]) != 0) fail("keys differ from the reference");
+    if (stable) {
+        same_contents(got, n, want, n);
+        free(want);
+        return ref;
+    }
+
+    /* same records, in any order among equal keys */
+    int *sa = (int *) malloc((n + 1) * sizeof(int));
+    int *sb = (int *) malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) { sa[i] = got[i].timestamp; sb[i] = want[i].timestamp; }
+    qsort(sa, n, sizeof(int), compare_serial);
+    qsort(sb, n, sizeof(int), compare_serial);
+    if (n > 0 && memcmp(sa, sb, n * sizeof(int)) != 0) fail("records differ from the reference");
+    free(sa);
+    free(sb);
+    free(want);
+
+    llist_destruct(ref);
+    ref = llist_construct(NULL);
+    for (int i = 0; i < n; i++) llist_insert(ref, copy_record(&got[i]), LLPOSITION_BACK);
+    llist_sort(ref, 6, fcomp);   /* already in order: sets the sorted state */
+    return ref;
+}
+
+static int compare_serial(const void *a, const void *b)
+{
+    int x = *(const int *) a, y = *(const int *) b;
+    return (x > y) - (x < y);
+}
+
+static void print_tally(const struct tally *t, const struct backend *B)
+{
+    printf("%s: %ld steps agree with llist: %ld inserts, %ld removes, %ld sorted inserts, "
+           "%ld accesses, %ld finds, sorts by type 1-8:",
+           backend, step - 1, t->inserts, t->removes, t->sorted_inserts, t->accesses, t->finds);
+    for (int type = 1; type <= 8; type++) printf("%s%ld", type == 1 ? " " : "/", t->sorts[type]);
+    printf("; %s %ld times, %s %ld times; max %d entries\n",
+           B->grew, t->grew, B->shrank, t->shrank, t->max_entries);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -6,7 +6,7 @@
  *
  * Purpose:
  *   Generic two-way linked list ADT used by MP2/MP3, plus llist_sort()
- *   implementing five sorting algorithms for a list of data_t*.
+ *   implementing eight sorting algorithms for a list of data_t*.
  *
  * Note:
  *   llist_debug_validate() is kept for API compatibility but is a no-op to
@@ -14,9 +14,19 @@
  */
 #define _GNU_SOURCE
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "llist.h"
+#include "simdsort.h"
+#include "pdqsort.h"
+#include "memacct.h"
 
 /* Private sorted-state flags */
 #define LLIST_SORTED    989898
@@ -28,6 +38,27 @@ static int comes_before(llist_t *L, const data_t *a, const data_t *b);
 static void detach_node(llist_t *L, llist_elem_t *node);
 static void push_back_node(llist_t *L, llist_elem_t *node);
 static llist_elem_t *pop_front_node(llist_t *L);
+static void insert_node_sorted(llist_t *L, llist_elem_t *node);
+static int in_compact_block(llist_t *L, const void *p);
+static void compact_release(llist_t *L, int nobjects);
+static void adopt_compact_block(llist_t *dst, llist_t *src);
+static void uncompact(llist_t *L);
+static data_t *release_node(llist_t *L, llist_elem_t *node);
+static llist_elem_t *new_node(llist_t *L, data_t *elem_ptr);
+static llist_elem_t *twin_of(llist_t *L, llist_elem_t *node);
+static void twin_link(llist_t *L, llist_elem_t *twin, int sorted);
+static void twin_unlink(llist_t *L, llist_elem_t *twin);
+static void twin_up(llist_t *L);
+static void twin_split(llist_t *L);
+static void dual_swap(llist_t *L);
+static int dual_switch(llist_t *L, int (*fcomp)(const data_t *, const data_t *));
+static int heap_before(llist_t *L, const llist_heap_entry_t *a, const llist_heap_entry_t *b);
+static void heap_push(llist_t *L, data_t *elem_ptr);
+static data_t *heap_pop(llist_t *L);
+static void heap_link(llist_t *L);
+static void heap_unlink(llist_t *L);
+static int merge_beats(llist_t **lists, int a, int b);
+static int loser_tree_build(llist_t **lists, int k, int *tree, int node);
 
 static void insertion_sort_list(llist_t *list_ptr);
 
@@ -42,12 +73,20 @@ static void merge_into(llist_t *dst, llist_t *left, llist_t *right);
 
 static int qsort_compare(const void *p_a, const void *p_b, void * lptr);
 
+static void *sort_arena_reserve(llist_t *L, size_t bytes);
+static void fill_node_array(llist_t *L, llist_elem_t **A);
+static void relink_from_array(llist_t *L, llist_elem_t **A, int n);
+static void array_merge_sort(llist_t *L, llist_elem_t **A, llist_elem_t **B, int n);
+
 /* ===== core ADT functions ===== */
 
 data_t *llist_access(llist_t *list_ptr, int pos_index)
 {
     assert(list_ptr);
     if (list_ptr->ll_entry_count == 0) return NULL;
+    if (list_ptr->ll_heap_count > 0 && (pos_index == LLPOSITION_FRONT || pos_index == 0))
+        return list_ptr->ll_heap[0].data_ptr;
+    heap_link(list_ptr);
 
     if (pos_index == LLPOSITION_FRONT || pos_index == 0)
         return list_ptr->ll_front->data_ptr;
@@ -70,33 +109,115 @@ data_t *llist_access(llist_t *list_ptr, int pos_index)
 
 llist_t *llist_construct(int (*fcomp)(const data_t *, const data_t *))
 {
-    llist_t *L = (llist_t *) malloc(sizeof(llist_t));
+    llist_t *L = (llist_t *) memacct_malloc(MEMACCT_LIST_HEADER, sizeof(llist_t));
     assert(L);
     L->ll_front = NULL;
     L->ll_back = NULL;
     L->ll_entry_count = 0;
     L->compare_fun = fcomp;
     L->ll_sorted_state = (fcomp ? LLIST_SORTED : LLIST_UNSORTED);
+    L->ll_sort_arena = NULL;
+    L->ll_sort_arena_bytes = 0;
+    L->ll_compact_block = NULL;
+    L->ll_compact_bytes = 0;
+    L->ll_compact_live = 0;
+    L->ll_autocompact = LLCOMPACT_OFF;
+    L->ll_heap_mode = 0;
+    L->ll_heap = NULL;
+    L->ll_heap_count = 0;
+    L->ll_heap_cap = 0;
+    L->ll_heap_seq = 0;
+    L->ll_dual = 0;
+    L->ll_twinned = 0;
+    L->ll_dual_half = 0;
+    L->ll_alt_front = NULL;
+    L->ll_alt_back = NULL;
+    L->ll_alt_sorted_state = LLIST_UNSORTED;
+    L->alt_compare_fun = NULL;
+    L->ll_borrowed = 0;
     return L;
 }
 
+llist_t *llist_clone(llist_t *list_ptr, int deep)
+{
+    assert(list_ptr);
+    heap_link(list_ptr);
+    llist_t *C = llist_construct(list_ptr->compare_fun);
+    C->ll_sorted_state = list_ptr->ll_sorted_state;
+    C->ll_borrowed = !deep;
+
+    int n = list_ptr->ll_entry_count;
+    if (n == 0) return C;
+    /* the [records | nodes] block of llist_compact, records only if deep */
+    size_t rec_bytes = deep ? n * sizeof(data_t) : 0;
+    size_t bytes = rec_bytes + n * sizeof(llist_elem_t);
+    char *block = (char *) memacct_malloc(MEMACCT_COMPACT, bytes);
+    assert(block);
+    data_t *recs = (data_t *) block;
+    llist_elem_t *nodes = (llist_elem_t *) (block + rec_bytes);
+
+    int i = 0;
+    for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next, i++) {
+        if (deep) {
+            recs[i] = *r->data_ptr;
+            nodes[i].data_ptr = &recs[i];
+        } else {
+            nodes[i].data_ptr = r->data_ptr;
+        }
+        nodes[i].ll_prev = (i > 0) ? &nodes[i-1] : NULL;
+        nodes[i].ll_next = (i < n-1) ? &nodes[i+1] : NULL;
+    }
+    assert(i == n);
+    C->ll_front = &nodes[0];
+    C->ll_back = &nodes[n-1];
+    C->ll_entry_count = n;
+    C->ll_compact_block = block;
+    C->ll_compact_bytes = bytes;
+    C->ll_compact_live = deep ? 2 * n : n;
+    return C;
+}
+
+llist_t *llist_construct_heap(int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(fcomp);
+    llist_t *L = llist_construct(fcomp);
+    L->ll_heap_mode = 1;
+    return L;
+}
+
+void llist_link(llist_t *list_ptr)
+{
+    assert(list_ptr);
+    heap_link(list_ptr);
+}
+
 void llist_destruct(llist_t *list_ptr)
 {
     assert(list_ptr);
     llist_elem_t *cur = list_ptr->ll_front;
     while (cur) {
         llist_elem_t *nxt = cur->ll_next;
-        free(cur->data_ptr);
-        free(cur);
+        if (!list_ptr->ll_borrowed && !in_compact_block(list_ptr, cur->data_ptr))
+            memacct_free(MEMACCT_RECORD, cur->data_ptr, sizeof(data_t));
+        if (list_ptr->ll_twinned)
+            memacct_free(MEMACCT_LIST_NODE, cur - list_ptr->ll_dual_half, 2 * sizeof(llist_elem_t));
+        else if (!in_compact_block(list_ptr, cur))
+            memacct_free(MEMACCT_LIST_NODE, cur, sizeof(llist_elem_t));
         cur = nxt;
     }
-    free(list_ptr);
+    for (int i = 0; i < list_ptr->ll_heap_count; i++)
+        memacct_free(MEMACCT_RECORD, list_ptr->ll_heap[i].data_ptr, sizeof(data_t));
+    memacct_free(MEMACCT_HEAP, list_ptr->ll_heap, list_ptr->ll_heap_cap * sizeof(llist_heap_entry_t));
+    memacct_free(MEMACCT_COMPACT, list_ptr->ll_compact_block, list_ptr->ll_compact_bytes);
+    memacct_free(MEMACCT_SORT_ARENA, list_ptr->ll_sort_arena, list_ptr->ll_sort_arena_bytes);
+    memacct_free(MEMACCT_LIST_HEADER, list_ptr, sizeof(llist_t));
 }
 
 data_t *llist_elem_find(llist_t *list_ptr, data_t *elem_ptr, int *pos_index,
                         int (*fcomp)(const data_t *, const data_t *))
 {
     assert(list_ptr && pos_index);
+    heap_link(list_ptr);
     *pos_index = -1;
     int idx = 0;
     for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next, idx++) {
@@ -112,11 +233,11 @@ void llist_insert(llist_t *list_ptr, data_t *elem_ptr, int pos_index)
 {
     assert(list_ptr);
     assert(pos_index == LLPOSITION_FRONT || pos_index == LLPOSITION_BACK || pos_index >= 0);
+    heap_link(list_ptr);
+    if (list_ptr->ll_entry_count == 0) twin_up(list_ptr);
 
-    llist_elem_t *node = (llist_elem_t *) malloc(sizeof(llist_elem_t));
-    assert(node);
-    node->data_ptr = elem_ptr;
-    node->ll_next = node->ll_prev = NULL;
+    llist_elem_t *node = new_node(list_ptr, elem_ptr);
+    if (list_ptr->ll_twinned) twin_link(list_ptr, twin_of(list_ptr, node), 0);
 
     if (list_ptr->ll_entry_count == 0) {
         list_ptr->ll_front = list_ptr->ll_back = node;
@@ -149,33 +270,16 @@ void llist_insert(llist_t *list_ptr, data_t *elem_ptr, int pos_index)
 void llist_insert_sorted(llist_t *list_ptr, data_t *elem_ptr)
 {
     assert(list_ptr && list_ptr->compare_fun && list_ptr->ll_sorted_state == LLIST_SORTED);
-
-    llist_elem_t *node = (llist_elem_t *) malloc(sizeof(llist_elem_t));
-    assert(node);
-    node->data_ptr = elem_ptr;
-    node->ll_next = node->ll_prev = NULL;
-
-    if (list_ptr->ll_entry_count == 0) {
-        list_ptr->ll_front = list_ptr->ll_back = node;
-    } else {
-        llist_elem_t *r = list_ptr->ll_front;
-        llist_elem_t *before = NULL;
-        while (r) {
-            if (list_ptr->compare_fun(elem_ptr, r->data_ptr) == 1) { before = r; break; }
-            r = r->ll_next;
-        }
-        if (!before) {
-            node->ll_prev = list_ptr->ll_back;
-            list_ptr->ll_back->ll_next = node;
-            list_ptr->ll_back = node;
-        } else {
-            node->ll_next = before;
-            node->ll_prev = before->ll_prev;
-            if (before->ll_prev) before->ll_prev->ll_next = node; else list_ptr->ll_front = node;
-            before->ll_prev = node;
-        }
+    if (list_ptr->ll_heap_mode) {
+        heap_unlink(list_ptr);
+        heap_push(list_ptr, elem_ptr);
+        return;
     }
-    list_ptr->ll_entry_count++;
+    if (list_ptr->ll_entry_count == 0) twin_up(list_ptr);
+
+    llist_elem_t *node = new_node(list_ptr, elem_ptr);
+    if (list_ptr->ll_twinned) twin_link(list_ptr, twin_of(list_ptr, node), 1);
+    insert_node_sorted(list_ptr, node);
 }
 
 data_t *llist_remove(llist_t *list_ptr, int pos_index)
@@ -184,6 +288,9 @@ data_t *llist_remove(llist_t *list_ptr, int pos_index)
     assert(pos_index == LLPOSITION_FRONT || pos_index == LLPOSITION_BACK || pos_index >= 0);
 
     if (list_ptr->ll_entry_count == 0) return NULL;
+    if (list_ptr->ll_heap_count > 0 && (pos_index == LLPOSITION_FRONT || pos_index == 0))
+        return heap_pop(list_ptr);
+    heap_link(list_ptr);
 
     llist_elem_t *t = NULL;
 
@@ -211,9 +318,14 @@ data_t *llist_remove(llist_t *list_ptr, int pos_index)
     }
 
     list_ptr->ll_entry_count--;
-    data_t *ret = t->data_ptr;
-    free(t);
-    return ret;
+    return release_node(list_ptr, t);
+}
+
+data_t *llist_remove_elem(llist_t *list_ptr, llist_elem_t *elem)
+{
+    assert(list_ptr && elem && list_ptr->ll_heap_count == 0);
+    detach_node(list_ptr, elem);
+    return release_node(list_ptr, elem);
 }
 
 int llist_entries(llist_t *list_ptr)
@@ -222,12 +334,28 @@ int llist_entries(llist_t *list_ptr)
     return list_ptr->ll_entry_count;
 }
 
+size_t llist_bytes(llist_t *list_ptr)
+{
+    assert(list_ptr);
+    size_t bytes = sizeof(llist_t) + list_ptr->ll_sort_arena_bytes + list_ptr->ll_compact_bytes
+                   + list_ptr->ll_heap_cap * sizeof(llist_heap_entry_t)
+                   + list_ptr->ll_heap_count * sizeof(data_t);
+    for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next) {
+        if (list_ptr->ll_twinned) bytes += 2 * sizeof(llist_elem_t);
+        else if (!in_compact_block(list_ptr, r)) bytes += sizeof(llist_elem_t);
+        if (!list_ptr->ll_borrowed && !in_compact_block(list_ptr, r->data_ptr)) bytes += sizeof(data_t);
+    }
+    return bytes;
+}
+
 /* ===== sorting ===== */
 
 void llist_sort(llist_t *list_ptr, int sort_type,
                 int (*fcomp)(const data_t *, const data_t *))
 {
     assert(list_ptr && fcomp);
+    heap_link(list_ptr);
+    if (dual_switch(list_ptr, fcomp)) return;
     list_ptr->compare_fun = fcomp;
 
     int original_size = llist_entries(list_ptr);
@@ -250,18 +378,25 @@ void llist_sort(llist_t *list_ptr, int sort_type,
         case 4: /* merge sort */
             mergesort_list(list_ptr);
             break;
-        case 5: { /* quick sort via qsort_r on array copy */
-            int Asize = llist_entries(list_ptr);
-            data_t **QsortA = (data_t **) malloc(Asize * sizeof(data_t *));
-            assert(QsortA);
-            for (int i = 0; i < Asize; i++) {
-                QsortA[i] = llist_remove(list_ptr, LLPOSITION_FRONT);
-            }
-            qsort_r(QsortA, Asize, sizeof(data_t *), qsort_compare, list_ptr);
-            for (int i = 0; i < Asize; i++) {
-                llist_insert(list_ptr, QsortA[i], LLPOSITION_BACK);
-            }
-            free(QsortA);
+        case 5: { /* quick sort via qsort_r on array of nodes */
+            llist_elem_t **QsortA = sort_arena_reserve(list_ptr, original_size * sizeof(llist_elem_t *));
+            fill_node_array(list_ptr, QsortA);
+            qsort_r(QsortA, original_size, sizeof(llist_elem_t *), qsort_compare, list_ptr);
+            relink_from_array(list_ptr, QsortA, original_size);
+            break;
+        }
+        case 6:   /* stable merge sort on array of nodes */
+        case 7: { /* key sort needs llist_sort_by_key; same order as 6 */
+            llist_elem_t **A = sort_arena_reserve(list_ptr, 2 * original_size * sizeof(llist_elem_t *));
+            fill_node_array(list_ptr, A);
+            array_merge_sort(list_ptr, A, A + original_size, original_size);
+            break;
+        }
+        case 8: { /* pattern-defeating quicksort on array of nodes */
+            llist_elem_t **A = sort_arena_reserve(list_ptr, original_size * sizeof(llist_elem_t *));
+            fill_node_array(list_ptr, A);
+            pdqsort_nodes(A, original_size, list_ptr->compare_fun);
+            relink_from_array(list_ptr, A, original_size);
             break;
         }
         default:
@@ -270,9 +405,336 @@ void llist_sort(llist_t *list_ptr, int sort_type,
 
     assert(llist_entries(list_ptr) == original_size);
     list_ptr->ll_sorted_state = LLIST_SORTED;
+    if (list_ptr->ll_autocompact != LLCOMPACT_OFF && !list_ptr->ll_dual)
+        llist_compact(list_ptr, list_ptr->ll_autocompact);
     llist_debug_validate(list_ptr);
 }
 
+void llist_sort_by_key(llist_t *list_ptr, int (*fkey)(const data_t *),
+                       int descending,
+                       int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(list_ptr && fkey && fcomp);
+    heap_link(list_ptr);
+    if (dual_switch(list_ptr, fcomp)) return;
+    list_ptr->compare_fun = fcomp;
+
+    int n = list_ptr->ll_entry_count;
+    if (n > 1) {
+        /* [nodes | keys | merge scratch] all from the list's arena */
+        size_t node_bytes = (n * sizeof(llist_elem_t *) + 7) & ~(size_t) 7;
+        char *arena = sort_arena_reserve(list_ptr, node_bytes + 2 * n * sizeof(int64_t));
+        llist_elem_t **nodes = (llist_elem_t **) arena;
+        int64_t *keys = (int64_t *) (arena + node_bytes);
+
+        int i = 0;
+        for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next, i++) {
+            int k = fkey(r->data_ptr);
+            nodes[i] = r;
+            keys[i] = SIMDSORT_PACK(descending ? ~k : k, i);
+        }
+        simdsort_i64(keys, keys + n, n);
+
+        /* relink in key order */
+        llist_elem_t *prev = NULL;
+        for (i = 0; i < n; i++) {
+            llist_elem_t *r = nodes[SIMDSORT_INDEX(keys[i])];
+            r->ll_prev = prev;
+            if (prev) prev->ll_next = r; else list_ptr->ll_front = r;
+            prev = r;
+        }
+        prev->ll_next = NULL;
+        list_ptr->ll_back = prev;
+    }
+    list_ptr->ll_sorted_state = LLIST_SORTED;
+    if (list_ptr->ll_autocompact != LLCOMPACT_OFF && !list_ptr->ll_dual)
+        llist_compact(list_ptr, list_ptr->ll_autocompact);
+    llist_debug_validate(list_ptr);
+}
+
+/* ===== splice and merge ===== */
+
+void llist_splice(llist_t *dst, llist_t *src)
+{
+    assert(dst && src && dst != src);
+    assert(!dst->ll_borrowed && !src->ll_borrowed);
+    heap_link(dst);
+    heap_link(src);
+    twin_split(dst);
+    twin_split(src);
+    if (src->ll_entry_count == 0) return;
+    adopt_compact_block(dst, src);
+
+    if (dst->ll_entry_count == 0) {
+        /* dst becomes src, including whether it is sorted */
+        dst->ll_front = src->ll_front;
+        dst->ll_sorted_state = src->ll_sorted_state;
+        if (src->ll_sorted_state == LLIST_SORTED) dst->compare_fun = src->compare_fun;
+    } else {
+        dst->ll_back->ll_next = src->ll_front;
+        src->ll_front->ll_prev = dst->ll_back;
+        if (dst->ll_sorted_state == LLIST_SORTED) dst->ll_sorted_state = LLIST_UNSORTED;
+    }
+    dst->ll_back = src->ll_back;
+    dst->ll_entry_count += src->ll_entry_count;
+
+    src->ll_front = src->ll_back = NULL;
+    src->ll_entry_count = 0;
+}
+
+void llist_merge(llist_t *dst, llist_t *src)
+{
+    assert(dst && src && dst != src);
+    assert(!dst->ll_borrowed && !src->ll_borrowed);
+    assert(dst->ll_sorted_state == LLIST_SORTED && src->ll_sorted_state == LLIST_SORTED);
+    heap_link(dst);
+    heap_link(src);
+    twin_split(dst);
+    twin_split(src);
+    adopt_compact_block(dst, src);
+    assert(dst->compare_fun && dst->compare_fun == src->compare_fun);
+
+    llist_t left;
+    init_empty_list(&left, dst->compare_fun, LLIST_SORTED);
+    left.ll_front = dst->ll_front;
+    left.ll_back = dst->ll_back;
+    left.ll_entry_count = dst->ll_entry_count;
+    dst->ll_front = dst->ll_back = NULL;
+    dst->ll_entry_count = 0;
+
+    /* unlike merge_into, take src only when strictly first */
+    while (left.ll_entry_count > 0 && src->ll_entry_count > 0) {
+        if (comes_before(dst, src->ll_front->data_ptr, left.ll_front->data_ptr)) {
+            push_back_node(dst, pop_front_node(src));
+        } else {
+            push_back_node(dst, pop_front_node(&left));
+        }
+    }
+    llist_splice(dst, &left);
+    llist_splice(dst, src);
+    dst->ll_sorted_state = LLIST_SORTED;
+}
+
+void llist_merge_sorted(llist_t *dst, llist_t *lists[], int k,
+                        int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(dst && dst->ll_entry_count == 0 && fcomp && k >= 0 && !dst->ll_borrowed);
+    assert(k <= LLIST_MERGE_MAX_WAYS);
+    assert(k == 0 || lists);
+    twin_split(dst);
+    for (int i = 0; i < k; i++) {
+        assert(lists[i] && lists[i] != dst && !lists[i]->ll_borrowed);
+        heap_link(lists[i]);
+        twin_split(lists[i]);
+        if (lists[i]->ll_entry_count == 0) continue;
+        assert(lists[i]->ll_sorted_state == LLIST_SORTED && lists[i]->compare_fun == fcomp);
+        adopt_compact_block(dst, lists[i]);
+    }
+    dst->compare_fun = fcomp;
+    dst->ll_sorted_state = LLIST_SORTED;
+    if (k == 0) return;
+
+    /* tree[1..k) hold the loser of each match, tree[0] the overall winner;
+     * leaf i sits at node k + i
+     */
+    int tree[LLIST_MERGE_MAX_WAYS];
+    tree[0] = loser_tree_build(lists, k, tree, 1);
+
+    while (lists[tree[0]]->ll_entry_count > 0) {
+        int w = tree[0];
+        push_back_node(dst, pop_front_node(lists[w]));
+        /* replay w's path to the root against the stored losers */
+        for (int node = (k + w) / 2; node > 0; node /= 2) {
+            if (merge_beats(lists, tree[node], w)) {
+                int t = tree[node];
+                tree[node] = w;
+                w = t;
+            }
+        }
+        tree[0] = w;
+    }
+}
+
+/* ===== compaction ===== */
+
+void llist_compact(llist_t *list_ptr, int mode)
+{
+    assert(list_ptr);
+    assert(mode == LLCOMPACT_NODES || mode == LLCOMPACT_RECORDS);
+    assert(!list_ptr->ll_borrowed);
+    heap_link(list_ptr);
+    twin_split(list_ptr);
+
+    int n = list_ptr->ll_entry_count;
+    if (n == 0) return;
+
+    /* records already in the old block must move too, whatever the mode */
+    int nrec = 0;
+    for (llist_elem_t *r = list_ptr->ll_front; r; r = r->ll_next) {
+        if (mode == LLCOMPACT_RECORDS || in_compact_block(list_ptr, r->data_ptr)) nrec++;
+    }
+
+    /* [records | nodes]: data_t first keeps both arrays naturally aligned */
+    size_t bytes = nrec * sizeof(data_t) + n * sizeof(llist_elem_t);
+    char *block = (char *) memacct_malloc(MEMACCT_COMPACT, bytes);
+    assert(block);
+    data_t *recs = (data_t *) block;
+    llist_elem_t *nodes = (llist_elem_t *) (block + nrec * sizeof(data_t));
+
+    int i = 0, j = 0;
+    llist_elem_t *r = list_ptr->ll_front;
+    while (r) {
+        llist_elem_t *nxt = r->ll_next;
+        if (mode == LLCOMPACT_RECORDS || in_compact_block(list_ptr, r->data_ptr)) {
+            recs[j] = *r->data_ptr;
+            if (!in_compact_block(list_ptr, r->data_ptr))
+                memacct_free(MEMACCT_RECORD, r->data_ptr, sizeof(data_t));
+            nodes[i].data_ptr = &recs[j++];
+        } else {
+            nodes[i].data_ptr = r->data_ptr;
+        }
+        nodes[i].ll_prev = (i > 0) ? &nodes[i-1] : NULL;
+        nodes[i].ll_next = (i < n-1) ? &nodes[i+1] : NULL;
+        if (!in_compact_block(list_ptr, r)) memacct_free(MEMACCT_LIST_NODE, r, sizeof(llist_elem_t));
+        r = nxt;
+        i++;
+    }
+    assert(i == n && j == nrec);
+
+    /* every object in the old block was live in this list and has moved */
+    memacct_free(MEMACCT_COMPACT, list_ptr->ll_compact_block, list_ptr->ll_compact_bytes);
+    list_ptr->ll_compact_block = block;
+    list_ptr->ll_compact_bytes = bytes;
+    list_ptr->ll_compact_live = n + nrec;
+    list_ptr->ll_front = &nodes[0];
+    list_ptr->ll_back = &nodes[n-1];
+}
+
+void llist_set_autocompact(llist_t *list_ptr, int mode)
+{
+    assert(list_ptr);
+    assert(mode == LLCOMPACT_OFF || mode == LLCOMPACT_NODES || mode == LLCOMPACT_RECORDS);
+    list_ptr->ll_autocompact = mode;
+}
+
+/* ===== dual order ===== */
+
+void llist_set_dual(llist_t *list_ptr, int on)
+{
+    assert(list_ptr && !list_ptr->ll_heap_mode);
+    list_ptr->ll_dual = (on != 0);
+    if (on) twin_up(list_ptr);
+    else    twin_split(list_ptr);
+}
+
+/* ===== snapshot files ===== */
+
+#define LLIST_FILE_MAGIC    "LLISTSNP"
+#define LLIST_FILE_VERSION  1
+
+typedef struct llist_file_header_tag {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;   /* sizeof(data_t) when written */
+    uint64_t count;
+    int32_t sorted;
+    int32_t compare_id;     /* 0 when unsorted or unregistered */
+} llist_file_header_t;
+
+static int (*compare_registry[LLIST_MAX_COMPARE_ID + 1])(const data_t *, const data_t *);
+
+void llist_register_compare(int id, int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(id >= 1 && id <= LLIST_MAX_COMPARE_ID && fcomp);
+    assert(compare_registry[id] == NULL || compare_registry[id] == fcomp);
+    compare_registry[id] = fcomp;
+}
+
+int llist_save(llist_t *list_ptr, const char *path)
+{
+    assert(list_ptr && path);
+    heap_link(list_ptr);
+    llist_file_header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, LLIST_FILE_MAGIC, sizeof(h.magic));
+    h.version = LLIST_FILE_VERSION;
+    h.record_size = sizeof(data_t);
+    h.count = list_ptr->ll_entry_count;
+    if (list_ptr->ll_sorted_state == LLIST_SORTED && list_ptr->compare_fun) {
+        for (int id = 1; id <= LLIST_MAX_COMPARE_ID; id++) {
+            if (compare_registry[id] == list_ptr->compare_fun) {
+                h.sorted = 1;
+                h.compare_id = id;
+                break;
+            }
+        }
+    }
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) return -1;
+    int ok = (fwrite(&h, sizeof(h), 1, fp) == 1);
+    for (llist_elem_t *r = list_ptr->ll_front; r && ok; r = r->ll_next) {
+        ok = (fwrite(r->data_ptr, sizeof(data_t), 1, fp) == 1);
+    }
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+llist_t *llist_load(const char *path)
+{
+    assert(path);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(llist_file_header_t)) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    const llist_file_header_t *h = (const llist_file_header_t *) map;
+    if (memcmp(h->magic, LLIST_FILE_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != LLIST_FILE_VERSION || h->record_size != sizeof(data_t) ||
+        h->count > INT32_MAX ||
+        (size_t) st.st_size != sizeof(*h) + h->count * sizeof(data_t) ||
+        h->compare_id < 0 || h->compare_id > LLIST_MAX_COMPARE_ID) {
+        munmap(map, st.st_size);
+        return NULL;
+    }
+
+    int (*fcomp)(const data_t *, const data_t *) = compare_registry[h->compare_id];
+    llist_t *L = llist_construct(NULL);
+    int n = (int) h->count;
+    if (n > 0) {
+        /* the same [records | nodes] block llist_compact builds */
+        size_t bytes = n * (sizeof(data_t) + sizeof(llist_elem_t));
+        char *block = (char *) memacct_malloc(MEMACCT_COMPACT, bytes);
+        assert(block);
+        data_t *recs = (data_t *) block;
+        llist_elem_t *nodes = (llist_elem_t *) (block + n * sizeof(data_t));
+        memcpy(recs, (const char *) map + sizeof(*h), n * sizeof(data_t));
+        for (int i = 0; i < n; i++) {
+            nodes[i].data_ptr = &recs[i];
+            nodes[i].ll_prev = (i > 0) ? &nodes[i-1] : NULL;
+            nodes[i].ll_next = (i < n-1) ? &nodes[i+1] : NULL;
+        }
+        L->ll_front = &nodes[0];
+        L->ll_back = &nodes[n-1];
+        L->ll_entry_count = n;
+        L->ll_compact_block = block;
+        L->ll_compact_bytes = bytes;
+        L->ll_compact_live = 2 * n;
+    }
+    if (h->sorted && fcomp) {
+        L->compare_fun = fcomp;
+        L->ll_sorted_state = LLIST_SORTED;
+    }
+    munmap(map, st.st_size);
+    return L;
+}
+
 /* ===== helpers ===== */
 
 static void init_empty_list(llist_t *L, int (*fcomp)(const data_t *, const data_t *), int sorted_state)
@@ -282,6 +744,361 @@ static void init_empty_list(llist_t *L, int (*fcomp)(const data_t *, const data_
     L->ll_entry_count = 0;
     L->compare_fun = fcomp;
     L->ll_sorted_state = sorted_state;
+    L->ll_sort_arena = NULL;
+    L->ll_sort_arena_bytes = 0;
+    L->ll_compact_block = NULL;
+    L->ll_compact_bytes = 0;
+    L->ll_compact_live = 0;
+    L->ll_autocompact = LLCOMPACT_OFF;
+    L->ll_heap_mode = 0;
+    L->ll_heap = NULL;
+    L->ll_heap_count = 0;
+    L->ll_heap_cap = 0;
+    L->ll_heap_seq = 0;
+    L->ll_dual = 0;
+    L->ll_twinned = 0;
+    L->ll_dual_half = 0;
+    L->ll_alt_front = NULL;
+    L->ll_alt_back = NULL;
+    L->ll_alt_sorted_state = LLIST_UNSORTED;
+    L->alt_compare_fun = NULL;
+    L->ll_borrowed = 0;
+}
+
+/* ----- priority-queue backend (llist_construct_heap) ----- */
+
+static int heap_before(llist_t *L, const llist_heap_entry_t *a, const llist_heap_entry_t *b)
+{
+    int c = L->compare_fun(a->data_ptr, b->data_ptr);
+    return c > 0 || (c == 0 && a->seq < b->seq);
+}
+
+static void heap_push(llist_t *L, data_t *elem_ptr)
+{
+    if (L->ll_heap_count == L->ll_heap_cap) {
+        int cap = L->ll_heap_cap ? 2 * L->ll_heap_cap : 64;
+        L->ll_heap = (llist_heap_entry_t *) memacct_realloc(MEMACCT_HEAP, L->ll_heap,
+                L->ll_heap_cap * sizeof(llist_heap_entry_t), cap * sizeof(llist_heap_entry_t));
+        assert(L->ll_heap);
+        L->ll_heap_cap = cap;
+    }
+    llist_heap_entry_t e = { elem_ptr, L->ll_heap_seq++ };
+    int i = L->ll_heap_count++;
+    while (i > 0 && heap_before(L, &e, &L->ll_heap[(i - 1) / 2])) {
+        L->ll_heap[i] = L->ll_heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    L->ll_heap[i] = e;
+    L->ll_entry_count++;
+}
+
+static data_t *heap_pop(llist_t *L)
+{
+    llist_heap_entry_t *h = L->ll_heap;
+    data_t *top = h[0].data_ptr;
+    llist_heap_entry_t last = h[--L->ll_heap_count];
+    int n = L->ll_heap_count;
+    int i = 0;
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= n) break;
+        if (c + 1 < n && heap_before(L, &h[c + 1], &h[c])) c++;
+        if (!heap_before(L, &h[c], &last)) break;
+        h[i] = h[c];
+        i = c;
+    }
+    if (n > 0) h[i] = last;
+    L->ll_entry_count--;
+    return top;
+}
+
+/* move the heap's entries onto the (empty) node chain in order */
+static void heap_link(llist_t *L)
+{
+    if (L->ll_heap_count == 0) return;
+    assert(L->ll_front == NULL);
+    int n = L->ll_heap_count;
+    for (int i = 0; i < n; i++) {
+        llist_elem_t *node = (llist_elem_t *) memacct_malloc(MEMACCT_LIST_NODE, sizeof(llist_elem_t));
+        assert(node);
+        node->data_ptr = heap_pop(L);
+        push_back_node(L, node);   /* heap_pop took the count down */
+    }
+    L->ll_heap_seq = 0;
+}
+
+/* move a sorted node chain into the heap: a sorted array with rising
+ * seq already satisfies the heap order, so no sifting is needed
+ */
+static void heap_unlink(llist_t *L)
+{
+    if (L->ll_front == NULL) return;
+    int n = L->ll_entry_count;
+    if (L->ll_heap_cap < n) {
+        L->ll_heap = (llist_heap_entry_t *) memacct_realloc(MEMACCT_HEAP, L->ll_heap,
+                L->ll_heap_cap * sizeof(llist_heap_entry_t), n * sizeof(llist_heap_entry_t));
+        assert(L->ll_heap);
+        L->ll_heap_cap = n;
+    }
+    for (int i = 0; i < n; i++) {
+        L->ll_heap[i].data_ptr = release_node(L, pop_front_node(L));
+        L->ll_heap[i].seq = L->ll_heap_seq++;
+    }
+    L->ll_heap_count = n;
+    L->ll_entry_count = n;
+}
+
+/* free an unlinked node and return its record, which the caller owns */
+static data_t *release_node(llist_t *L, llist_elem_t *node)
+{
+    data_t *ret = node->data_ptr;
+    if (in_compact_block(L, ret)) {
+        /* the caller frees what it removes, so give it a heap copy */
+        ret = (data_t *) memacct_malloc(MEMACCT_RECORD, sizeof(data_t));
+        assert(ret);
+        *ret = *node->data_ptr;
+        compact_release(L, 1);
+    }
+    if (L->ll_twinned) {
+        twin_unlink(L, twin_of(L, node));
+        memacct_free(MEMACCT_LIST_NODE, node - L->ll_dual_half, 2 * sizeof(llist_elem_t));
+    } else if (in_compact_block(L, node)) {
+        compact_release(L, 1);
+    } else {
+        memacct_free(MEMACCT_LIST_NODE, node, sizeof(llist_elem_t));
+    }
+    return ret;
+}
+
+/* an unlinked node for elem_ptr; on a twinned list both twins are
+ * allocated together and the other one is left for twin_link
+ */
+static llist_elem_t *new_node(llist_t *L, data_t *elem_ptr)
+{
+    int twins = L->ll_twinned ? 2 : 1;
+    llist_elem_t *pair = (llist_elem_t *) memacct_malloc(MEMACCT_LIST_NODE, twins * sizeof(llist_elem_t));
+    assert(pair);
+    for (int i = 0; i < twins; i++) {
+        pair[i].data_ptr = elem_ptr;
+        pair[i].ll_prev = pair[i].ll_next = NULL;
+    }
+    return L->ll_twinned ? &pair[L->ll_dual_half] : pair;
+}
+
+/* ----- dual order (llist_set_dual) ----- */
+
+/* the second-chain twin of a node on the ll_front chain */
+static llist_elem_t *twin_of(llist_t *L, llist_elem_t *node)
+{
+    return L->ll_dual_half ? node - 1 : node + 1;
+}
+
+/* put a new node's twin on the second chain: in order when sorted is set
+ * and that chain is sorted, else at its back (leaving it unsorted)
+ */
+static void twin_link(llist_t *L, llist_elem_t *twin, int sorted)
+{
+    llist_elem_t *before = NULL;
+    if (sorted && L->ll_alt_sorted_state == LLIST_SORTED) {
+        for (before = L->ll_alt_front; before; before = before->ll_next)
+            if (L->alt_compare_fun(twin->data_ptr, before->data_ptr) == 1) break;
+    } else {
+        L->ll_alt_sorted_state = LLIST_UNSORTED;
+    }
+    if (before) {
+        twin->ll_next = before;
+        twin->ll_prev = before->ll_prev;
+        if (before->ll_prev) before->ll_prev->ll_next = twin; else L->ll_alt_front = twin;
+        before->ll_prev = twin;
+    } else {
+        twin->ll_prev = L->ll_alt_back;
+        if (L->ll_alt_back) L->ll_alt_back->ll_next = twin; else L->ll_alt_front = twin;
+        L->ll_alt_back = twin;
+    }
+}
+
+static void twin_unlink(llist_t *L, llist_elem_t *twin)
+{
+    if (twin->ll_prev) twin->ll_prev->ll_next = twin->ll_next; else L->ll_alt_front = twin->ll_next;
+    if (twin->ll_next) twin->ll_next->ll_prev = twin->ll_prev; else L->ll_alt_back = twin->ll_prev;
+}
+
+/* give every node of a dual list a twin; the second chain starts as a
+ * copy of the first, sorted the same way
+ */
+static void twin_up(llist_t *L)
+{
+    if (!L->ll_dual || L->ll_twinned) return;
+    llist_elem_t *r = L->ll_front;
+    llist_elem_t *prev = NULL, *alt_prev = NULL;
+    L->ll_twinned = 1;
+    L->ll_dual_half = 0;
+    L->ll_front = L->ll_alt_front = NULL;
+    while (r) {
+        llist_elem_t *nxt = r->ll_next;
+        llist_elem_t *node = new_node(L, r->data_ptr);
+        llist_elem_t *twin = twin_of(L, node);
+        node->ll_prev = prev;
+        if (prev) prev->ll_next = node; else L->ll_front = node;
+        twin->ll_prev = alt_prev;
+        if (alt_prev) alt_prev->ll_next = twin; else L->ll_alt_front = twin;
+        prev = node;
+        alt_prev = twin;
+        if (in_compact_block(L, r)) compact_release(L, 1);
+        else memacct_free(MEMACCT_LIST_NODE, r, sizeof(llist_elem_t));
+        r = nxt;
+    }
+    L->ll_back = prev;
+    L->ll_alt_back = alt_prev;
+    L->ll_alt_sorted_state = L->ll_sorted_state;
+    L->alt_compare_fun = L->compare_fun;
+}
+
+/* back to one node per entry in ll_front order; the second chain is lost */
+static void twin_split(llist_t *L)
+{
+    if (!L->ll_twinned) return;
+    llist_elem_t *r = L->ll_front;
+    llist_elem_t *prev = NULL;
+    int half = L->ll_dual_half;
+    L->ll_twinned = 0;
+    L->ll_front = NULL;
+    while (r) {
+        llist_elem_t *nxt = r->ll_next;
+        llist_elem_t *node = new_node(L, r->data_ptr);
+        node->ll_prev = prev;
+        if (prev) prev->ll_next = node; else L->ll_front = node;
+        prev = node;
+        memacct_free(MEMACCT_LIST_NODE, r - half, 2 * sizeof(llist_elem_t));
+        r = nxt;
+    }
+    L->ll_back = prev;
+    L->ll_dual_half = 0;
+    L->ll_alt_front = L->ll_alt_back = NULL;
+    L->ll_alt_sorted_state = LLIST_UNSORTED;
+    L->alt_compare_fun = NULL;
+}
+
+static void dual_swap(llist_t *L)
+{
+    llist_elem_t *front = L->ll_front, *back = L->ll_back;
+    int state = L->ll_sorted_state;
+    int (*fcomp)(const data_t *, const data_t *) = L->compare_fun;
+    L->ll_front = L->ll_alt_front;
+    L->ll_back = L->ll_alt_back;
+    L->ll_sorted_state = L->ll_alt_sorted_state;
+    L->compare_fun = L->alt_compare_fun;
+    L->ll_alt_front = front;
+    L->ll_alt_back = back;
+    L->ll_alt_sorted_state = state;
+    L->alt_compare_fun = fcomp;
+    L->ll_dual_half ^= 1;
+}
+
+/* before a sort by fcomp: bring the chain last ordered by fcomp to the
+ * front, or if neither was, keep the current order on the second chain.
+ * Returns 1 when the chain swapped in is already sorted.
+ */
+static int dual_switch(llist_t *L, int (*fcomp)(const data_t *, const data_t *))
+{
+    if (!L->ll_dual) return 0;
+    twin_up(L);
+    if (L->alt_compare_fun == fcomp || L->compare_fun != fcomp) {
+        dual_swap(L);
+        if (L->ll_sorted_state == LLIST_SORTED && L->compare_fun == fcomp) return 1;
+    }
+    return 0;
+}
+
+static int in_compact_block(llist_t *L, const void *p)
+{
+    const char *base = (const char *) L->ll_compact_block;
+    return base && (const char *) p >= base && (const char *) p < base + L->ll_compact_bytes;
+}
+
+/* drop nobjects from the compact block; free it once nothing lives there */
+static void compact_release(llist_t *L, int nobjects)
+{
+    L->ll_compact_live -= nobjects;
+    assert(L->ll_compact_live >= 0);
+    if (L->ll_compact_live == 0) {
+        memacct_free(MEMACCT_COMPACT, L->ll_compact_block, L->ll_compact_bytes);
+        L->ll_compact_block = NULL;
+        L->ll_compact_bytes = 0;
+    }
+}
+
+/* before src's nodes move into dst: hand dst src's compact block, or if
+ * dst already has one, give src's nodes and records their own mallocs
+ */
+static void adopt_compact_block(llist_t *dst, llist_t *src)
+{
+    if (src->ll_compact_block == NULL) return;
+    if (dst->ll_compact_block == NULL) {
+        dst->ll_compact_block = src->ll_compact_block;
+        dst->ll_compact_bytes = src->ll_compact_bytes;
+        dst->ll_compact_live = src->ll_compact_live;
+        src->ll_compact_block = NULL;
+        src->ll_compact_bytes = 0;
+        src->ll_compact_live = 0;
+    } else {
+        uncompact(src);
+    }
+}
+
+static void uncompact(llist_t *L)
+{
+    llist_elem_t *prev = NULL;
+    llist_elem_t *r = L->ll_front;
+    while (r) {
+        llist_elem_t *nxt = r->ll_next;
+        llist_elem_t *node = r;
+        if (in_compact_block(L, r)) {
+            node = (llist_elem_t *) memacct_malloc(MEMACCT_LIST_NODE, sizeof(llist_elem_t));
+            assert(node);
+            *node = *r;
+        }
+        if (in_compact_block(L, node->data_ptr)) {
+            data_t *rec = (data_t *) memacct_malloc(MEMACCT_RECORD, sizeof(data_t));
+            assert(rec);
+            *rec = *node->data_ptr;
+            node->data_ptr = rec;
+        }
+        node->ll_prev = prev;
+        if (prev) prev->ll_next = node; else L->ll_front = node;
+        prev = node;
+        r = nxt;
+    }
+    L->ll_back = prev;
+    memacct_free(MEMACCT_COMPACT, L->ll_compact_block, L->ll_compact_bytes);
+    L->ll_compact_block = NULL;
+    L->ll_compact_bytes = 0;
+    L->ll_compact_live = 0;
+}
+
+/* does list a's front come out ahead of list b's?  Empty lists lose,
+ * and ties go to the lower index
+ */
+static int merge_beats(llist_t **lists, int a, int b)
+{
+    if (lists[b]->ll_entry_count == 0) return lists[a]->ll_entry_count > 0 || a < b;
+    if (lists[a]->ll_entry_count == 0) return 0;
+    int c = lists[a]->compare_fun(lists[a]->ll_front->data_ptr, lists[b]->ll_front->data_ptr);
+    return c > 0 || (c == 0 && a < b);
+}
+
+/* play the matches below node; returns the winning list index */
+static int loser_tree_build(llist_t **lists, int k, int *tree, int node)
+{
+    if (node >= k) return node - k;
+    int a = loser_tree_build(lists, k, tree, 2 * node);
+    int b = loser_tree_build(lists, k, tree, 2 * node + 1);
+    if (merge_beats(lists, a, b)) {
+        tree[node] = b;
+        return a;
+    }
+    tree[node] = a;
+    return b;
 }
 
 static int comes_before(llist_t *L, const data_t *a, const data_t *b)
@@ -300,21 +1117,45 @@ static void detach_node(llist_t *L, llist_elem_t *node)
     L->ll_entry_count--;
 }
 
+/* insert an unlinked node into a sorted list, after any equal entries */
+static void insert_node_sorted(llist_t *L, llist_elem_t *node)
+{
+    if (L->ll_entry_count == 0) {
+        L->ll_front = L->ll_back = node;
+    } else {
+        llist_elem_t *r = L->ll_front;
+        llist_elem_t *before = NULL;
+        while (r) {
+            if (L->compare_fun(node->data_ptr, r->data_ptr) == 1) { before = r; break; }
+            r = r->ll_next;
+        }
+        if (!before) {
+            node->ll_prev = L->ll_back;
+            L->ll_back->ll_next = node;
+            L->ll_back = node;
+        } else {
+            node->ll_next = before;
+            node->ll_prev = before->ll_prev;
+            if (before->ll_prev) before->ll_prev->ll_next = node; else L->ll_front = node;
+            before->ll_prev = node;
+        }
+    }
+    L->ll_entry_count++;
+}
+
 /* ----- insertion sort using second list ----- */
 static void insertion_sort_list(llist_t *list_ptr)
 {
-    llist_t *sorted = llist_construct(list_ptr->compare_fun);
-    sorted->ll_sorted_state = LLIST_SORTED;
+    llist_t sorted;
+    init_empty_list(&sorted, list_ptr->compare_fun, LLIST_SORTED);
 
     while (list_ptr->ll_entry_count > 0) {
-        data_t *moved = llist_remove(list_ptr, LLPOSITION_FRONT);
-        llist_insert_sorted(sorted, moved);
+        insert_node_sorted(&sorted, pop_front_node(list_ptr));
     }
 
-    list_ptr->ll_front = sorted->ll_front;
-    list_ptr->ll_back = sorted->ll_back;
-    list_ptr->ll_entry_count = sorted->ll_entry_count;
-    free(sorted);
+    list_ptr->ll_front = sorted.ll_front;
+    list_ptr->ll_back = sorted.ll_back;
+    list_ptr->ll_entry_count = sorted.ll_entry_count;
 }
 
 /* ----- recursive selection sort (Standish 5.19/5.20) ----- */
@@ -336,21 +1177,20 @@ static void selection_sort_recur(llist_t *work, llist_t *out)
 
 static void selection_sort_recursive(llist_t *list_ptr)
 {
-    llist_t *out = llist_construct(list_ptr->compare_fun);
-    init_empty_list(out, list_ptr->compare_fun, LLIST_UNSORTED);
-    selection_sort_recur(list_ptr, out);
+    llist_t out;
+    init_empty_list(&out, list_ptr->compare_fun, LLIST_UNSORTED);
+    selection_sort_recur(list_ptr, &out);
 
-    list_ptr->ll_front = out->ll_front;
-    list_ptr->ll_back = out->ll_back;
-    list_ptr->ll_entry_count = out->ll_entry_count;
-    free(out);
+    list_ptr->ll_front = out.ll_front;
+    list_ptr->ll_back = out.ll_back;
+    list_ptr->ll_entry_count = out.ll_entry_count;
 }
 
 /* ----- iterative selection sort (Standish 5.35) ----- */
 static void selection_sort_iterative(llist_t *list_ptr)
 {
-    llist_t *out = llist_construct(list_ptr->compare_fun);
-    init_empty_list(out, list_ptr->compare_fun, LLIST_UNSORTED);
+    llist_t out;
+    init_empty_list(&out, list_ptr->compare_fun, LLIST_UNSORTED);
 
     while (list_ptr->ll_entry_count > 0) {
         llist_elem_t *best = list_ptr->ll_front;
@@ -360,13 +1200,12 @@ static void selection_sort_iterative(llist_t *list_ptr)
             }
         }
         detach_node(list_ptr, best);
-        push_back_node(out, best);
+        push_back_node(&out, best);
     }
 
-    list_ptr->ll_front = out->ll_front;
-    list_ptr->ll_back = out->ll_back;
-    list_ptr->ll_entry_count = out->ll_entry_count;
-    free(out);
+    list_ptr->ll_front = out.ll_front;
+    list_ptr->ll_back = out.ll_back;
+    list_ptr->ll_entry_count = out.ll_entry_count;
 }
 
 /* ----- merge sort (Standish 6.19) ----- */
@@ -412,7 +1251,8 @@ static void split_in_half(llist_t *src, llist_t *left, llist_t *right)
 
 static void merge_into(llist_t *dst, llist_t *left, llist_t *right)
 {
-    init_empty_list(dst, left->compare_fun, LLIST_UNSORTED);
+    /* dst was emptied by split_in_half; keep its arena and compact block */
+    assert(dst->ll_entry_count == 0);
 
     while (left->ll_entry_count > 0 && right->ll_entry_count > 0) {
         if (comes_before(left, left->ll_front->data_ptr, right->ll_front->data_ptr)) {
@@ -450,11 +1290,92 @@ static llist_elem_t *pop_front_node(llist_t *L)
     return node;
 }
 
-/* ----- quick sort comparison helper ----- */
+/* ----- quick sort comparison helper -----
+ * compare_fun returns 1 when a comes first; qsort_r wants a negative value.
+ */
 static int qsort_compare(const void *p_a, const void *p_b, void * lptr)
 {
     llist_t *list_ptr = (llist_t *) lptr;
-    return list_ptr->compare_fun(*(data_t * const *)p_a, *(data_t * const *)p_b);
+    const llist_elem_t *a = *(llist_elem_t * const *)p_a;
+    const llist_elem_t *b = *(llist_elem_t * const *)p_b;
+    return -list_ptr->compare_fun(a->data_ptr, b->data_ptr);
+}
+
+/* ----- array sorts: scratch arena and node-array helpers ----- */
+
+/* Return the list's scratch arena with room for at least the given bytes.
+ * The arena only grows, so steady-state sorts never touch the heap.
+ */
+static void *sort_arena_reserve(llist_t *L, size_t bytes)
+{
+    if (bytes > L->ll_sort_arena_bytes) {
+        size_t cap = L->ll_sort_arena_bytes > 0 ? L->ll_sort_arena_bytes : 512;
+        while (cap < bytes) cap *= 2;
+        memacct_free(MEMACCT_SORT_ARENA, L->ll_sort_arena, L->ll_sort_arena_bytes);
+        L->ll_sort_arena = memacct_malloc(MEMACCT_SORT_ARENA, cap);
+        assert(L->ll_sort_arena);
+        L->ll_sort_arena_bytes = cap;
+    }
+    return L->ll_sort_arena;
+}
+
+static void fill_node_array(llist_t *L, llist_elem_t **A)
+{
+    int i = 0;
+    for (llist_elem_t *r = L->ll_front; r; r = r->ll_next) A[i++] = r;
+    assert(i == L->ll_entry_count);
+}
+
+static void relink_from_array(llist_t *L, llist_elem_t **A, int n)
+{
+    for (int i = 0; i < n; i++) {
+        A[i]->ll_prev = (i > 0) ? A[i-1] : NULL;
+        A[i]->ll_next = (i < n-1) ? A[i+1] : NULL;
+    }
+    L->ll_front = A[0];
+    L->ll_back = A[n-1];
+}
+
+/* ----- stable merge sort on node array -----
+ * Runs of MSORT_RUN are insertion sorted in place, then merged bottom-up
+ * ping-ponging between A and B.  Ties always take the left element, so
+ * equal keys keep their original list order.
+ */
+#define MSORT_RUN 16
+
+static void array_merge_sort(llist_t *L, llist_elem_t **A, llist_elem_t **B, int n)
+{
+    for (int lo = 0; lo < n; lo += MSORT_RUN) {
+        int hi = (lo + MSORT_RUN < n) ? lo + MSORT_RUN : n;
+        for (int i = lo + 1; i < hi; i++) {
+            llist_elem_t *x = A[i];
+            int j = i;
+            while (j > lo && comes_before(L, x->data_ptr, A[j-1]->data_ptr)) {
+                A[j] = A[j-1];
+                j--;
+            }
+            A[j] = x;
+        }
+    }
+
+    llist_elem_t **src = A, **dst = B;
+    for (int width = MSORT_RUN; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = (lo + width < n) ? lo + width : n;
+            int hi = (lo + 2 * width < n) ? lo + 2 * width : n;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (comes_before(L, src[j]->data_ptr, src[i]->data_ptr))
+                    dst[k++] = src[j++];
+                else
+                    dst[k++] = src[i++];
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        llist_elem_t **t = src; src = dst; dst = t;
+    }
+    relink_from_array(L, src, n);
 }
 
 /* ===== debug validator (no-op for speed) ===== */
@@ -4,12 +4,18 @@
 #ifndef LLIST_H
 #define LLIST_H
 
+#include <stddef.h>
 #include "datatypes.h"
 
 /* Special index values for head/tail operations */
 #define LLPOSITION_FRONT   (-987654)
 #define LLPOSITION_BACK    (-234567)
 
+/* llist_compact modes (also used for the auto-compact setting) */
+#define LLCOMPACT_OFF      0
+#define LLCOMPACT_NODES    1   /* move list nodes only */
+#define LLCOMPACT_RECORDS  2   /* move nodes and their data_t records */
+
 /* Node and header (opaque to users of the ADT) */
 typedef struct llist_element_tag {
     data_t *data_ptr;
@@ -17,12 +23,37 @@ typedef struct llist_element_tag {
     struct llist_element_tag *ll_next;
 } llist_elem_t;
 
+/* priority-queue entry; seq keeps equal keys in insertion order */
+typedef struct llist_heap_entry_tag {
+    data_t *data_ptr;
+    unsigned long seq;
+} llist_heap_entry_t;
+
 typedef struct llist_header_tag {
     llist_elem_t *ll_front;
     llist_elem_t *ll_back;
     int ll_entry_count;
     int ll_sorted_state;  /* private flag used only by llist.c */
     int (*compare_fun)(const data_t *, const data_t *);
+    void *ll_sort_arena;           /* scratch kept across llist_sort calls */
+    size_t ll_sort_arena_bytes;    /* capacity of ll_sort_arena */
+    void *ll_compact_block;        /* [records | nodes] placed by llist_compact */
+    size_t ll_compact_bytes;
+    int ll_compact_live;           /* objects still inside ll_compact_block */
+    int ll_autocompact;            /* LLCOMPACT_* mode run after each sort */
+    int ll_heap_mode;              /* built by llist_construct_heap */
+    llist_heap_entry_t *ll_heap;   /* binary heap; the node chain is empty while it holds entries */
+    int ll_heap_count;
+    int ll_heap_cap;
+    unsigned long ll_heap_seq;
+    int ll_dual;                   /* llist_set_dual: keep a second ordering */
+    int ll_twinned;                /* nodes are twin pairs, one per chain */
+    int ll_dual_half;              /* which twin of each pair ll_front's chain uses */
+    llist_elem_t *ll_alt_front;    /* the second chain, through the other twins */
+    llist_elem_t *ll_alt_back;
+    int ll_alt_sorted_state;
+    int (*alt_compare_fun)(const data_t *, const data_t *);
+    int ll_borrowed;               /* llist_clone(..., 0): records belong to the source */
 } llist_t;
 
 /* MP2 functions */
@@ -35,11 +66,133 @@ int       llist_entries(llist_t *list_ptr);
 void      llist_insert(llist_t *list_ptr, data_t *elem_ptr, int pos_index);
 void      llist_insert_sorted(llist_t *list_ptr, data_t *elem_ptr);
 data_t *  llist_remove(llist_t *list_ptr, int pos_index);
+/* O(1) removal of a node the caller already holds (it must be in list_ptr) */
+data_t *  llist_remove_elem(llist_t *list_ptr, llist_elem_t *elem);
+/* bytes the list holds: header, nodes, records (not a shallow clone's),
+ * sort arena, compact block and heap array, without allocator overhead;
+ * walks the list, O(n)
+ */
+size_t    llist_bytes(llist_t *list_ptr);
+
+/* Copy of list_ptr in the same order, sorted state and compare_fun, with
+ * every node (and with deep set, every record) in one block laid out as
+ * llist_compact does.  A shallow clone (deep 0) points at list_ptr's
+ * records: it must not outlive them, llist_destruct leaves them alone,
+ * what llist_remove returns from it is not the caller's to free, and it
+ * cannot be spliced, merged or compacted.  A deep clone is independent.
+ */
+llist_t * llist_clone(llist_t *list_ptr, int deep);
+
+/* Priority-queue backend.  A list built this way keeps what
+ * llist_insert_sorted adds in a binary heap, so sorted insert and
+ * llist_remove / llist_access at LLPOSITION_FRONT (or 0) cost O(log n);
+ * entries that compare equal still come out in insertion order.  Any
+ * other call links the heap into the node chain in order first (O(n log n)
+ * once), and the next sorted insert moves the chain back into the heap.
+ * Code that walks ll_front directly must call llist_link first.
+ */
+llist_t * llist_construct_heap(int (*fcomp)(const data_t *, const data_t *));
+
+/* Put every entry on the ll_front chain in order: links a heap-mode list's
+ * heap into nodes, and does nothing for any other list.
+ */
+void      llist_link(llist_t *list_ptr);
 
-/* MP3 sorting */
+/* Dual order.  After llist_set_dual(list_ptr, 1) each node is one of a
+ * pair of twins sharing a record: one twin is on the ll_front chain, the
+ * other on a second chain that keeps the order the list had before it was
+ * last sorted by another comparator.  llist_sort or llist_sort_by_key with
+ * the comparator that chain is sorted by swaps the chains in O(1) instead
+ * of sorting; ties then keep the order they had when that chain was
+ * sorted.  Positional inserts put the twin at the back of the second
+ * chain, which is re-sorted when it is next swapped in; llist_insert_sorted
+ * keeps both chains sorted; removals unlink both twins.  Splice, merge and
+ * compact split the pairs into single nodes, and the next sort pairs them
+ * up again (O(n)); auto-compact is skipped while dual.  Node pointers held
+ * across a sort may be on either chain, so llist_remove_elem callers must
+ * turn dual off first.  Not for llist_construct_heap lists.
+ */
+void      llist_set_dual(llist_t *list_ptr, int on);
+
+/* MP3 sorting
+ *   sort_type 1: insertion      2: recursive selection
+ *             3: iterative selection   4: merge (linked)
+ *             5: qsort_r on node array
+ *             6: stable array merge sort (ping-pong buffers)
+ *             7: key sort; needs llist_sort_by_key, else runs as 6
+ *             8: pattern-defeating quicksort (pdqsort.h)
+ * Array sorts (5-8) use a scratch arena owned by the list, so repeated
+ * sorts of the same list do no heap allocation once the arena has grown.
+ */
 void      llist_sort(llist_t *list_ptr, int sort_type,
                      int (*fcomp)(const data_t *, const data_t *));
 
+/* Sort type 7: order by an integer key with the SIMD sort kernels
+ * (simdsort.h).  Equal keys keep list order.  fcomp must agree with the
+ * key order and is kept for later llist_insert_sorted calls.
+ */
+void      llist_sort_by_key(llist_t *list_ptr, int (*fkey)(const data_t *),
+                            int descending,
+                            int (*fcomp)(const data_t *, const data_t *));
+
+/* Move every node of src onto the back of dst in O(1); src is left empty.
+ * An empty dst takes over src's sorted state and compare_fun.  If both
+ * lists hold a compact block (see llist_compact), src's entries are first
+ * copied out of its block, which costs O(len(src)).
+ */
+void      llist_splice(llist_t *dst, llist_t *src);
+
+/* Stable merge of two lists already sorted with the same compare_fun:
+ * src's nodes are merged into dst (dst's entries first on ties) and src
+ * is left empty.  dst stays sorted.  Compact blocks as for llist_splice.
+ */
+void      llist_merge(llist_t *dst, llist_t *src);
+
+/* k-way merge through a loser tree: every node of lists[0..k) moves onto
+ * the empty list dst in fcomp order, about log2(k) comparisons per node.
+ * Each non-empty input must be sorted with fcomp; ties go to the lower
+ * list index, so merging runs in input order is stable.  The inputs are
+ * left empty.
+ *
+ * The tree is k ints on the stack, so k is at most LLIST_MERGE_MAX_WAYS
+ * and plain linked inputs are merged without allocating.  Inputs in
+ * another mode are converted first, and that does allocate: a heap-mode
+ * list gets a node per entry, a dual-order list (dst too) is split back
+ * to single nodes, and when several inputs own compact blocks all but
+ * the first are copied out, as for llist_splice.
+ */
+#define LLIST_MERGE_MAX_WAYS 1024
+void      llist_merge_sorted(llist_t *dst, llist_t *lists[], int k,
+                             int (*fcomp)(const data_t *, const data_t *));
+
+/* Move the nodes (and with LLCOMPACT_RECORDS the records) into one new
+ * block in list order, so later walks read memory sequentially.  Records
+ * moved into the block stay owned by the list: llist_remove hands back a
+ * malloc'd copy, so callers still free what they remove.  Record pointers
+ * held outside the list are invalidated by LLCOMPACT_RECORDS.
+ */
+void      llist_compact(llist_t *list_ptr, int mode);
+
+/* Run llist_compact(list_ptr, mode) at the end of every llist_sort and
+ * llist_sort_by_key; LLCOMPACT_OFF (the default) turns it off.
+ */
+void      llist_set_autocompact(llist_t *list_ptr, int mode);
+
+/* Snapshot files.  The layout is pointer-free: a fixed header (magic,
+ * version, record size, count, sorted flag, comparator id) and then the
+ * data_t records packed in list order, in host byte order.  Comparators
+ * are stored by the id given to llist_register_compare (1..15); a list
+ * sorted by an unregistered comparator is saved as unsorted.
+ */
+#define LLIST_MAX_COMPARE_ID 15
+void      llist_register_compare(int id, int (*fcomp)(const data_t *, const data_t *));
+/* returns 0, or -1 if the file could not be written */
+int       llist_save(llist_t *list_ptr, const char *path);
+/* mmaps path and builds the nodes and records in one compact block;
+ * returns NULL if the file is missing or is not a snapshot
+ */
+llist_t * llist_load(const char *path);
+
 /* Debug validator provided by template (do not remove decl). */
 void      llist_debug_validate(llist_t *L);
 
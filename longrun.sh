@@ -11,7 +11,7 @@
 # MP3 place in student directory
 if [ ! -f ./geninput ]; then
     if [ -f ./geninput.c ]; then
-        gcc geninput.c -o geninput
+        gcc geninput.c workload.c -o geninput -lm
     else
         echo "geninput.c file not found! Check why not in repository!"
         exit 1
@@ -19,9 +19,11 @@ if [ ! -f ./geninput ]; then
 fi
 echo "this script should run in less than 2 seconds"
 seed=09292025
-./geninput 10000 1 1 gen $seed | ./lab3 
-./geninput 10000 1 2 ip $seed | ./lab3 
-./geninput 10000 1 3 gen $seed | ./lab3 
-./geninput 300000 1 4 ip $seed | ./lab3  
-./geninput 500000 1 5 gen $seed | ./lab3  
+# LAB3=./lab3-pgo ./longrun.sh times the make lab3-pgo build instead
+lab3=${LAB3:-./lab3}
+./geninput 10000 1 1 gen $seed | $lab3 
+./geninput 10000 1 2 ip $seed | $lab3 
+./geninput 10000 1 3 gen $seed | $lab3 
+./geninput 300000 1 4 ip $seed | $lab3  
+./geninput 500000 1 5 gen $seed | $lab3  
 
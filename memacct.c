@@ -0,0 +1,143 @@
+/* memacct.c
+ * ECE 2230 Fall 2025
+ * MP3 — allocation accounting for lab3 -M
+ *
+ * Purpose:
+ *   Per-site counters behind the memacct_* wrappers.  The enabled flag is
+ *   set once before any thread starts, so reading it needs no ordering;
+ *   the counters use relaxed atomics and the peak a compare-exchange loop.
+ */
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <assert.h>
+
+#include "memacct.h"
+
+typedef struct memacct_site_tag {
+    atomic_long allocs;
+    atomic_long frees;
+    atomic_llong live;
+} memacct_site_t;
+
+static const char *site_names[MEMACCT_NSITES] = {
+    "list header", "list node", "record", "sort arena", "compact block",
+    "heap array", "ids scratch", "cold tier",
+};
+
+static int enabled;
+static memacct_site_t sites[MEMACCT_NSITES];
+static atomic_llong total_live;
+static atomic_llong total_peak;
+static atomic_llong mark_peak;
+
+/* ===== private helpers ===== */
+static void count_alloc(int site, size_t bytes);
+static void count_free(int site, size_t bytes);
+static void raise_to(atomic_llong *peak, long long live);
+
+void memacct_enable(void)
+{
+    enabled = 1;
+}
+
+int memacct_enabled(void)
+{
+    return enabled;
+}
+
+void *memacct_malloc(int site, size_t bytes)
+{
+    void *p = malloc(bytes);
+    if (enabled && p) count_alloc(site, bytes);
+    return p;
+}
+
+void *memacct_calloc(int site, size_t count, size_t size)
+{
+    void *p = calloc(count, size);
+    if (enabled && p) count_alloc(site, count * size);
+    return p;
+}
+
+void *memacct_realloc(int site, void *p, size_t old_bytes, size_t new_bytes)
+{
+    void *q = realloc(p, new_bytes);
+    if (enabled && q) {
+        if (p) count_free(site, old_bytes);
+        count_alloc(site, new_bytes);
+    }
+    return q;
+}
+
+void memacct_free(int site, void *p, size_t bytes)
+{
+    if (p == NULL) return;
+    if (enabled) count_free(site, bytes);
+    free(p);
+}
+
+long long memacct_live(void)
+{
+    return atomic_load_explicit(&total_live, memory_order_relaxed);
+}
+
+long long memacct_peak(void)
+{
+    return atomic_load_explicit(&total_peak, memory_order_relaxed);
+}
+
+long long memacct_mark(void)
+{
+    long long live = memacct_live();
+    atomic_store_explicit(&mark_peak, live, memory_order_relaxed);
+    return live;
+}
+
+long long memacct_mark_peak(void)
+{
+    return atomic_load_explicit(&mark_peak, memory_order_relaxed);
+}
+
+void memacct_print(FILE *fp)
+{
+    fprintf(fp, "Allocations\tallocs\tfrees\tlive_bytes\n");
+    for (int i = 0; i < MEMACCT_NSITES; i++) {
+        fprintf(fp, "%s\t%ld\t%ld\t%lld\n", site_names[i],
+                atomic_load_explicit(&sites[i].allocs, memory_order_relaxed),
+                atomic_load_explicit(&sites[i].frees, memory_order_relaxed),
+                atomic_load_explicit(&sites[i].live, memory_order_relaxed));
+    }
+    fprintf(fp, "total\t\t\t%lld (peak %lld)\n", memacct_live(), memacct_peak());
+}
+
+/* ===== helpers ===== */
+
+static void count_alloc(int site, size_t bytes)
+{
+    assert(site >= 0 && site < MEMACCT_NSITES);
+    atomic_fetch_add_explicit(&sites[site].allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&sites[site].live, (long long) bytes, memory_order_relaxed);
+    long long live = atomic_fetch_add_explicit(&total_live, (long long) bytes, memory_order_relaxed)
+                     + (long long) bytes;
+    raise_to(&total_peak, live);
+    raise_to(&mark_peak, live);
+}
+
+static void count_free(int site, size_t bytes)
+{
+    assert(site >= 0 && site < MEMACCT_NSITES);
+    atomic_fetch_add_explicit(&sites[site].frees, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&sites[site].live, (long long) bytes, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&total_live, (long long) bytes, memory_order_relaxed);
+}
+
+static void raise_to(atomic_llong *peak, long long live)
+{
+    long long seen = atomic_load_explicit(peak, memory_order_relaxed);
+    while (live > seen &&
+           !atomic_compare_exchange_weak_explicit(peak, &seen, live,
+                                                  memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,54 @@
+/* memacct.h
+ * Allocation accounting for the list ADT and the ids_support layer
+ *
+ * llist.c, ids_support.c and the modules that free records they get back
+ * from the list allocate through these wrappers, tagged with the call
+ * site.  Accounting is off until memacct_enable (lab3 -M); while off the
+ * wrappers are malloc/free plus one branch.  When on, each site counts
+ * allocations, frees and live bytes, and the process keeps its total
+ * live bytes and their high-water mark.  Counters are atomic, so builder
+ * and background-sort threads may allocate concurrently; the peak is then
+ * a process-wide figure, not one sort's alone.
+ *
+ * Frees pass the size they release; the allocator's own overhead (about
+ * 16 bytes per block with glibc) is not counted.
+ */
+#ifndef MEMACCT_H
+#define MEMACCT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define MEMACCT_LIST_HEADER  0   /* llist_t from llist_construct */
+#define MEMACCT_LIST_NODE    1   /* one llist_elem_t per entry */
+#define MEMACCT_RECORD       2   /* alert_t records the list owns */
+#define MEMACCT_SORT_ARENA   3   /* llist_sort / merge scratch arrays */
+#define MEMACCT_COMPACT      4   /* llist_compact / llist_load blocks */
+#define MEMACCT_HEAP         5   /* llist_construct_heap entry array */
+#define MEMACCT_SCRATCH      6   /* ids_support temporaries */
+#define MEMACCT_COLD         7   /* coldtier blocks, table and cache */
+#define MEMACCT_NSITES       8
+
+void   memacct_enable(void);
+int    memacct_enabled(void);
+
+void * memacct_malloc(int site, size_t bytes);
+void * memacct_calloc(int site, size_t count, size_t size);
+void * memacct_realloc(int site, void *p, size_t old_bytes, size_t new_bytes);
+void   memacct_free(int site, void *p, size_t bytes);
+
+/* bytes live across all sites, and the most there have been */
+long long memacct_live(void);
+long long memacct_peak(void);
+
+/* start a second high-water mark at the current live bytes and return
+ * them; memacct_mark_peak is the most live since (lab3 brackets each
+ * sort with these)
+ */
+long long memacct_mark(void);
+long long memacct_mark_peak(void);
+
+/* per-site table: allocs, frees, live bytes */
+void   memacct_print(FILE *fp);
+
+#endif
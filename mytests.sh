@@ -28,7 +28,7 @@ build_binaries() {
   if ! have ./geninput; then
     if have ./geninput.c; then
       msg "building geninput from geninput.c…"
-      gcc -Wall -g geninput.c -o geninput
+      gcc -Wall -g geninput.c workload.c -o geninput -lm
     else
       msg "ERROR: geninput(c) missing"; exit 2
     fi
@@ -0,0 +1,335 @@
+/* pdqsort.c
+ * ECE 2230 Fall 2025
+ * MP3 — Pattern-defeating quicksort (sort type 8)
+ *
+ * Purpose:
+ *   Quicksort over llist_elem_t* arrays after O. Peters' pdqsort:
+ *     - insertion sort below PDQ_INSERTION_CUTOFF elements
+ *     - median-of-3 pivots, Tukey's ninther above PDQ_NINTHER_CUTOFF
+ *     - branchless block partitioning (BlockQuicksort): comparisons only
+ *       record offsets into small buffers, then misplaced elements are
+ *       swapped in bulk, so mispredicted branches do not scale with n
+ *     - runs of keys equal to the previous pivot are split off by
+ *       partition_left in one linear pass, so duplicate-heavy input
+ *       (geninput's repeated 'records' and 0 keys) stays O(n log n)
+ *     - already partitioned ranges get a bounded insertion sort pass,
+ *       so sorted and reverse-sorted input finish in O(n)
+ *     - unbalanced partitions shuffle a few elements; after log2(n) of
+ *       them the range falls back to heapsort, bounding the worst case
+ */
+
+#include <stdlib.h>
+#include "pdqsort.h"
+
+#define PDQ_INSERTION_CUTOFF   24
+#define PDQ_NINTHER_CUTOFF     128
+#define PDQ_PARTIAL_LIMIT      8
+#define PDQ_BLOCK              64
+
+typedef llist_elem_t *elem;
+typedef int (*cmp_fn)(const data_t *, const data_t *);
+
+/* a strictly comes before b */
+#define LESS(a, b)   (fcomp((a)->data_ptr, (b)->data_ptr) > 0)
+#define SWAP(a, b)   do { elem t_ = *(a); *(a) = *(b); *(b) = t_; } while (0)
+
+static void pdq_loop(elem *begin, elem *end, cmp_fn fcomp, int bad_allowed, int leftmost);
+
+/* ===== small helpers ===== */
+
+static void insertion_sort(elem *begin, elem *end, cmp_fn fcomp)
+{
+    if (begin == end) return;
+    for (elem *cur = begin + 1; cur != end; ++cur) {
+        elem *sift = cur, *sift_1 = cur - 1;
+        if (LESS(*sift, *sift_1)) {
+            elem tmp = *sift;
+            do { *sift-- = *sift_1; } while (sift != begin && LESS(tmp, *--sift_1));
+            *sift = tmp;
+        }
+    }
+}
+
+/* begin[-1] is known to be <= every element, so no bounds check */
+static void unguarded_insertion_sort(elem *begin, elem *end, cmp_fn fcomp)
+{
+    if (begin == end) return;
+    for (elem *cur = begin + 1; cur != end; ++cur) {
+        elem *sift = cur, *sift_1 = cur - 1;
+        if (LESS(*sift, *sift_1)) {
+            elem tmp = *sift;
+            do { *sift-- = *sift_1; } while (LESS(tmp, *--sift_1));
+            *sift = tmp;
+        }
+    }
+}
+
+/* insertion sort that gives up after PDQ_PARTIAL_LIMIT moves;
+ * returns 1 if the range ended up sorted
+ */
+static int partial_insertion_sort(elem *begin, elem *end, cmp_fn fcomp)
+{
+    if (begin == end) return 1;
+    long limit = 0;
+    for (elem *cur = begin + 1; cur != end; ++cur) {
+        elem *sift = cur, *sift_1 = cur - 1;
+        if (LESS(*sift, *sift_1)) {
+            elem tmp = *sift;
+            do { *sift-- = *sift_1; } while (sift != begin && LESS(tmp, *--sift_1));
+            *sift = tmp;
+            limit += cur - sift;
+        }
+        if (limit > PDQ_PARTIAL_LIMIT) return 0;
+    }
+    return 1;
+}
+
+static void sort2(elem *a, elem *b, cmp_fn fcomp)
+{
+    if (LESS(*b, *a)) SWAP(a, b);
+}
+
+static void sort3(elem *a, elem *b, elem *c, cmp_fn fcomp)
+{
+    sort2(a, b, fcomp);
+    sort2(b, c, fcomp);
+    sort2(a, b, fcomp);
+}
+
+static void sift_down(elem *v, long root, long n, cmp_fn fcomp)
+{
+    elem x = v[root];
+    for (;;) {
+        long child = 2 * root + 1;
+        if (child >= n) break;
+        if (child + 1 < n && LESS(v[child], v[child + 1])) child++;
+        if (!LESS(x, v[child])) break;
+        v[root] = v[child];
+        root = child;
+    }
+    v[root] = x;
+}
+
+static void heap_sort(elem *begin, elem *end, cmp_fn fcomp)
+{
+    long n = end - begin;
+    for (long i = n / 2 - 1; i >= 0; i--) sift_down(begin, i, n, fcomp);
+    for (long i = n - 1; i > 0; i--) {
+        SWAP(begin, begin + i);
+        sift_down(begin, 0, i, fcomp);
+    }
+}
+
+/* ===== partitioning ===== */
+
+/* swap num element pairs named by the offset buffers; with distinct
+ * counts a cyclic permutation saves one move per element
+ */
+static void swap_offsets(elem *first, elem *last, const unsigned char *offsets_l,
+                         const unsigned char *offsets_r, int num, int use_swaps)
+{
+    if (use_swaps) {
+        for (int i = 0; i < num; i++) SWAP(first + offsets_l[i], last - offsets_r[i]);
+    } else if (num > 0) {
+        elem *l = first + offsets_l[0];
+        elem *r = last - offsets_r[0];
+        elem tmp = *l;
+        *l = *r;
+        for (int i = 1; i < num; i++) {
+            l = first + offsets_l[i]; *r = *l;
+            r = last - offsets_r[i];  *l = *r;
+        }
+        *r = tmp;
+    }
+}
+
+/* Partition around *begin into [< pivot][pivot][>= pivot].  Returns the
+ * pivot position; *already_partitioned is set when no swap was needed.
+ */
+static elem *partition_right_branchless(elem *begin, elem *end, cmp_fn fcomp,
+                                        int *already_partitioned)
+{
+    elem pivot = *begin;
+    elem *first = begin, *last = end;
+
+    while (LESS(*++first, pivot));
+    if (first - 1 == begin) while (first < last && !LESS(*--last, pivot));
+    else                    while (!LESS(*--last, pivot));
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned) {
+        SWAP(first, last);
+        ++first;
+
+        unsigned char offsets_l[PDQ_BLOCK], offsets_r[PDQ_BLOCK];
+        elem *offsets_l_base = first, *offsets_r_base = last;
+        int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            long num_unknown = last - first;
+            long left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            long right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+            /* record offsets only; the loop body has no data-dependent branch */
+            if (left_split >= PDQ_BLOCK) {
+                for (int i = 0; i < PDQ_BLOCK; i++) {
+                    offsets_l[num_l] = (unsigned char) i;
+                    num_l += !LESS(*first, pivot);
+                    ++first;
+                }
+            } else {
+                for (int i = 0; i < left_split; i++) {
+                    offsets_l[num_l] = (unsigned char) i;
+                    num_l += !LESS(*first, pivot);
+                    ++first;
+                }
+            }
+            if (right_split >= PDQ_BLOCK) {
+                for (int i = 0; i < PDQ_BLOCK; ) {
+                    offsets_r[num_r] = (unsigned char) ++i;
+                    num_r += LESS(*--last, pivot);
+                }
+            } else {
+                for (int i = 0; i < right_split; ) {
+                    offsets_r[num_r] = (unsigned char) ++i;
+                    num_r += LESS(*--last, pivot);
+                }
+            }
+
+            int num = num_l < num_r ? num_l : num_r;
+            swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                         offsets_r + start_r, num, num_l == num_r);
+            num_l -= num; num_r -= num;
+            start_l += num; start_r += num;
+            if (num_l == 0) { start_l = 0; offsets_l_base = first; }
+            if (num_r == 0) { start_r = 0; offsets_r_base = last; }
+        }
+
+        /* one buffer may still hold misplaced elements */
+        if (num_l) {
+            while (num_l--) { --last; SWAP(offsets_l_base + offsets_l[start_l + num_l], last); }
+            first = last;
+        }
+        if (num_r) {
+            while (num_r--) { SWAP(offsets_r_base - offsets_r[start_r + num_r], first); ++first; }
+            last = first;
+        }
+    }
+
+    elem *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/* Partition around *begin into [<= pivot][pivot][> pivot].  Used when the
+ * pivot equals the element left of the range, so every key equal to the
+ * pivot lands left and is never looked at again.
+ */
+static elem *partition_left(elem *begin, elem *end, cmp_fn fcomp)
+{
+    elem pivot = *begin;
+    elem *first = begin, *last = end;
+
+    while (LESS(pivot, *--last));
+    if (last + 1 == end) while (first < last && !LESS(pivot, *++first));
+    else                 while (!LESS(pivot, *++first));
+
+    while (first < last) {
+        SWAP(first, last);
+        while (LESS(pivot, *--last));
+        while (!LESS(pivot, *++first));
+    }
+
+    elem *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/* ===== main loop ===== */
+
+static void pdq_loop(elem *begin, elem *end, cmp_fn fcomp, int bad_allowed, int leftmost)
+{
+    for (;;) {
+        long size = end - begin;
+        if (size < PDQ_INSERTION_CUTOFF) {
+            if (leftmost) insertion_sort(begin, end, fcomp);
+            else          unguarded_insertion_sort(begin, end, fcomp);
+            return;
+        }
+
+        /* choose pivot and move it to *begin */
+        long s2 = size / 2;
+        if (size > PDQ_NINTHER_CUTOFF) {
+            sort3(begin, begin + s2, end - 1, fcomp);
+            sort3(begin + 1, begin + (s2 - 1), end - 2, fcomp);
+            sort3(begin + 2, begin + (s2 + 1), end - 3, fcomp);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), fcomp);
+            SWAP(begin, begin + s2);
+        } else {
+            sort3(begin + s2, begin, end - 1, fcomp);
+        }
+
+        /* pivot equal to the left neighbour: strip the run of equal keys */
+        if (!leftmost && !LESS(*(begin - 1), *begin)) {
+            begin = partition_left(begin, end, fcomp) + 1;
+            continue;
+        }
+
+        int already_partitioned;
+        elem *pivot_pos = partition_right_branchless(begin, end, fcomp, &already_partitioned);
+
+        long l_size = pivot_pos - begin;
+        long r_size = end - (pivot_pos + 1);
+        int highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            if (--bad_allowed == 0) {
+                heap_sort(begin, end, fcomp);
+                return;
+            }
+            /* break up patterns that keep producing bad pivots */
+            if (l_size >= PDQ_INSERTION_CUTOFF) {
+                SWAP(begin, begin + l_size / 4);
+                SWAP(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > PDQ_NINTHER_CUTOFF) {
+                    SWAP(begin + 1, begin + (l_size / 4 + 1));
+                    SWAP(begin + 2, begin + (l_size / 4 + 2));
+                    SWAP(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    SWAP(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= PDQ_INSERTION_CUTOFF) {
+                SWAP(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                SWAP(end - 1, end - r_size / 4);
+                if (r_size > PDQ_NINTHER_CUTOFF) {
+                    SWAP(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    SWAP(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    SWAP(end - 2, end - (1 + r_size / 4));
+                    SWAP(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned &&
+                   partial_insertion_sort(begin, pivot_pos, fcomp) &&
+                   partial_insertion_sort(pivot_pos + 1, end, fcomp)) {
+            return;
+        }
+
+        /* recurse on the left part, loop on the right */
+        pdq_loop(begin, pivot_pos, fcomp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+
+void pdqsort_nodes(llist_elem_t **v, int n,
+                   int (*fcomp)(const data_t *, const data_t *))
+{
+    if (n < 2) return;
+    int log2n = 0;
+    while ((1 << (log2n + 1)) <= n) log2n++;
+    pdq_loop(v, v + n, fcomp, log2n, 1);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
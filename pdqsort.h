@@ -0,0 +1,18 @@
+/* pdqsort.h
+ * Pattern-defeating quicksort over arrays of list nodes
+ *
+ * In-tree replacement for qsort_r on the node arrays built by llist_sort.
+ * Not stable.  Uses no heap memory and O(log n) stack.
+ */
+#ifndef PDQSORT_H
+#define PDQSORT_H
+
+#include "llist.h"
+
+/* sort v[0..n) so that fcomp(v[i]->data_ptr, v[i+1]->data_ptr) != -1;
+ * fcomp follows the list ADT convention (1 when a comes first)
+ */
+void pdqsort_nodes(llist_elem_t **v, int n,
+                   int (*fcomp)(const data_t *, const data_t *));
+
+#endif
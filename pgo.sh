@@ -0,0 +1,103 @@
+#!/usr/bin/env bash
+# pgo.sh — training runs and speedup report for the lab3-pgo build
+# Usage:
+#   ./pgo.sh train BIN                     # run the training workloads through BIN
+#   ./pgo.sh compare O0 O2 LTO PGO [reps]  # per-sort times (fastest of reps, default 5)
+# Notes:
+#   - make lab3-pgo calls "train" on the instrumented binary; make pgo-report
+#     calls "compare ./lab3 ./lab3-o2 ./lab3-lto ./lab3-pgo" and keeps a
+#     copy in results/
+#   - training covers every sort type, both fields and every geninput list
+#     type, plus one columnar (-c) and one pipelined (-p) run per field
+#   - lab3 is the -O0 debug build.  The profile's share is pgo_gain, the
+#     profiled build against the same -O2 -flto build without a profile;
+#     the last line names every sort the profile made slower
+#   - the array sorts (5, 6) call the comparator through list_ptr->compare_fun.
+#     The profile sees both ids comparators there, about evenly, and GCC
+#     promotes only one target: it inlines ids_compare_destip behind a
+#     pointer check.  So ip sorts gain from the profile and gen sorts gain
+#     nothing and pay the check, which is sort 5 gen's loss against -flto.
+#     Sort 5 also spends most of its time in libc's qsort_r, which no flag
+#     here recompiles (-O2 gains it about 1.2x, sorts 4 and 6 about 2x).
+set -euo pipefail
+
+seed=09292025
+
+# list sizes: the quadratic sorts get fewer records
+size_for() {
+  case "$1" in
+    1|2|3) echo "$2" ;;
+    *)     echo "$3" ;;
+  esac
+}
+
+train() {
+  local bin="$1"
+  for sort in 1 2 3 4 5 6 7 8; do
+    local n
+    n=$(size_for "$sort" 3000 100000)
+    for field in gen ip; do
+      for list in 1 2 3 4 5 6 7 8 9; do
+        ./geninput "$n" "$list" "$sort" "$field" "$seed" | "$bin" > /dev/null
+      done
+    done
+  done
+  for field in gen ip; do
+    ./geninput 100000 1 6 "$field" "$seed" | "$bin" -c > /dev/null
+    ./geninput 100000 1 6 "$field" "$seed" | "$bin" -p 2 > /dev/null 2>&1
+  done
+}
+
+# fastest sort time in ms of reps runs of one geninput workload.  Other
+# processes only ever add time, and on a one-CPU machine they add 20-30%
+# to some runs, which swings a median more than the builds differ.
+sort_ms() {
+  local bin="$1" n="$2" sort="$3" field="$4" reps="$5"
+  for ((r = 0; r < reps; r++)); do
+    ./geninput "$n" 1 "$sort" "$field" "$seed" | "$bin" | awk -F'\t' 'NF == 3 { print $2 }'
+  done | sort -g | head -n 1
+}
+
+compare() {
+  local o0="$1" o2="$2" lto="$3" pgo="$4" reps="${5:-5}"
+  printf "# O0:  %s, built -Wall -g with no -O flag\n" "$o0"
+  printf "# O2:  %s, -O2; LTO: %s, -O2 -flto; neither has a profile\n" "$o2" "$lto"
+  printf "# PGO: %s, -O2 -flto -fprofile-use; pgo_gain = lto_ms / pgo_ms\n" "$pgo"
+  printf "# times: fastest of %d runs, random input (geninput list type 1)\n" "$reps"
+  printf "sort\tfield\tN\tO0_ms\tO2_ms\tlto_ms\tpgo_ms\tpgo_gain\n"
+  local logs="0 0 0" count=0 slower=""
+  for sort in 1 2 3 4 5 6 7 8; do
+    local n
+    n=$(size_for "$sort" 8000 300000)
+    for field in gen ip; do
+      local a b c d
+      a=$(sort_ms "$o0" "$n" "$sort" "$field" "$reps")
+      b=$(sort_ms "$o2" "$n" "$sort" "$field" "$reps")
+      c=$(sort_ms "$lto" "$n" "$sort" "$field" "$reps")
+      d=$(sort_ms "$pgo" "$n" "$sort" "$field" "$reps")
+      awk -v s="$sort" -v f="$field" -v n="$n" -v a="$a" -v b="$b" -v c="$c" -v d="$d" \
+        'BEGIN { printf "%s\t%s\t%d\t%.2f\t%.2f\t%.2f\t%.2f\t%.2fx\n", s, f, n, a, b, c, d, c / d }'
+      logs=$(awk -v l="$logs" -v a="$a" -v b="$b" -v c="$c" -v d="$d" \
+        'BEGIN { split(l, v, " "); print v[1] + log(a / b), v[2] + log(b / c), v[3] + log(c / d) }')
+      slower+=$(awk -v s="$sort" -v f="$field" -v c="$c" -v d="$d" \
+        'BEGIN { if (d > c) printf " %s %s (%.2fx)", s, f, c / d }')
+      count=$((count + 1))
+    done
+  done
+  awk -v l="$logs" -v c="$count" 'BEGIN {
+    split(l, v, " ")
+    printf "geomean over %d sorts: O2 %.2fx over O0, LTO %.2fx over O2, PGO %.2fx over LTO\n",
+           c, exp(v[1] / c), exp(v[2] / c), exp(v[3] / c)
+  }'
+  echo "slower with pgo than lto:${slower:- none}"
+}
+
+if [ ! -x ./geninput ]; then
+  make geninput >&2
+fi
+case "${1:-}" in
+  train)   [ $# -eq 2 ] || { echo "usage: $0 train BIN" >&2; exit 1; }; train "$2" ;;
+  compare) [ $# -ge 5 ] || { echo "usage: $0 compare O0 O2 LTO PGO [reps]" >&2; exit 1; }
+           compare "$2" "$3" "$4" "$5" "${6:-5}" ;;
+  *)       echo "usage: $0 train BIN | compare O0 O2 LTO PGO [reps]" >&2; exit 1 ;;
+esac
@@ -0,0 +1,333 @@
+/* pipeline.c
+ * ECE 2230 Fall 2025
+ * MP3 — pipelined ingest for lab3 -p
+ *
+ * Purpose:
+ *   Reader -> builders -> splice.  The reader packs APPENDREAR lines into
+ *   batches; builder threads from a small pool turn each batch into a
+ *   shard list; pipeline_sync joins the shards onto the queue in batch
+ *   order.  Before a stable sort the shards are sorted in parallel and
+ *   merged instead of spliced.  The same pool runs those sorts and merges.
+ *
+ *   Unstable sort types are not pre-sorted: their order among equal keys
+ *   depends on the input order the algorithm sees, so sorting shards and
+ *   merging them would not reproduce single-threaded output.
+ */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "pipeline.h"
+#include "ids_support.h"
+
+#define PIPELINE_MAX_PENDING_PER_THREAD 4
+
+typedef struct batch_tag {
+    char *text;          /* NUL-separated lines */
+    size_t used;
+    size_t cap;
+    int nlines;
+    llist_t *shard;      /* filled in by a builder */
+} batch_t;
+
+typedef struct task_tag {
+    void (*fn)(pipeline_t *p, void *arg);
+    void *arg;
+    struct task_tag *next;
+} task_t;
+
+typedef struct merge_pair_tag {
+    llist_t *left;
+    llist_t *right;
+} merge_pair_t;
+
+struct pipeline_tag {
+    llist_t *queue;
+    int nbuilders;
+    int batch_lines;
+    pthread_t *threads;
+
+    pthread_mutex_t mu;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+    task_t *task_head;
+    task_t *task_tail;
+    int pending;         /* queued or running tasks */
+    int stop;
+
+    batch_t *cur;        /* being filled by the reader */
+    batch_t **shards;    /* built since the last sync, in input order */
+    int nshards;
+    int shard_cap;
+
+    /* presort parameters for the current sync */
+    void (*presort)(llist_t *, int);
+    int sort_type;
+
+    /* per-stage counters */
+    double t_start;
+    long lines;
+    long built;
+    double build_busy_ms;
+    double sync_ms;
+    int spliced;
+    int merged;
+};
+
+/* ===== private helpers ===== */
+static double ms_now(void);
+static void *worker_main(void *argp);
+static void submit(pipeline_t *p, void (*fn)(pipeline_t *, void *), void *arg);
+static void wait_idle(pipeline_t *p);
+static void submit_batch(pipeline_t *p);
+static void build_task(pipeline_t *p, void *arg);
+static void presort_task(pipeline_t *p, void *arg);
+static void merge_task(pipeline_t *p, void *arg);
+
+pipeline_t *pipeline_construct(llist_t *queue, int nbuilders, int batch_lines)
+{
+    assert(queue && nbuilders > 0 && batch_lines > 0);
+    pipeline_t *p = (pipeline_t *) calloc(1, sizeof(pipeline_t));
+    assert(p);
+    p->queue = queue;
+    p->nbuilders = nbuilders;
+    p->batch_lines = batch_lines;
+    pthread_mutex_init(&p->mu, NULL);
+    pthread_cond_init(&p->work_cv, NULL);
+    pthread_cond_init(&p->done_cv, NULL);
+    p->t_start = ms_now();
+
+    p->threads = (pthread_t *) malloc(nbuilders * sizeof(pthread_t));
+    assert(p->threads);
+    for (int i = 0; i < nbuilders; i++) {
+        int rc = pthread_create(&p->threads[i], NULL, worker_main, p);
+        assert(rc == 0);
+    }
+    return p;
+}
+
+void pipeline_destruct(pipeline_t *p)
+{
+    assert(p);
+    pipeline_sync(p, NULL, 0, NULL);
+
+    pthread_mutex_lock(&p->mu);
+    p->stop = 1;
+    pthread_cond_broadcast(&p->work_cv);
+    pthread_mutex_unlock(&p->mu);
+    for (int i = 0; i < p->nbuilders; i++) pthread_join(p->threads[i], NULL);
+
+    /* the reader stage is whatever the main thread spent outside syncs */
+    double read_ms = ms_now() - p->t_start - p->sync_ms;
+    fprintf(stderr, "pipeline: read   %ld lines in %.1f ms (%.0f lines/s)\n",
+            p->lines, read_ms, read_ms > 0 ? p->lines / (read_ms / 1000.0) : 0.0);
+    fprintf(stderr, "pipeline: build  %ld records on %d threads, %.1f ms busy (%.0f records/s per thread)\n",
+            p->built, p->nbuilders, p->build_busy_ms,
+            p->build_busy_ms > 0 ? p->built / (p->build_busy_ms / 1000.0) : 0.0);
+    fprintf(stderr, "pipeline: join   %d shards spliced, %d presorted and merged, %.1f ms\n",
+            p->spliced, p->merged, p->sync_ms);
+
+    pthread_cond_destroy(&p->done_cv);
+    pthread_cond_destroy(&p->work_cv);
+    pthread_mutex_destroy(&p->mu);
+    free(p->threads);
+    free(p->shards);
+    free(p);
+}
+
+void pipeline_append_line(pipeline_t *p, const char *line)
+{
+    assert(p && line);
+    batch_t *b = p->cur;
+    if (b == NULL) {
+        b = (batch_t *) calloc(1, sizeof(batch_t));
+        assert(b);
+        b->cap = (size_t) p->batch_lines * 32;
+        b->text = (char *) malloc(b->cap);
+        assert(b->text);
+        p->cur = b;
+    }
+    size_t len = strlen(line) + 1;
+    if (b->used + len > b->cap) {
+        b->cap = 2 * (b->used + len);
+        b->text = (char *) realloc(b->text, b->cap);
+        assert(b->text);
+    }
+    memcpy(b->text + b->used, line, len);
+    b->used += len;
+    b->nlines++;
+    p->lines++;
+    if (b->nlines == p->batch_lines) submit_batch(p);
+}
+
+void pipeline_sync(pipeline_t *p, void (*presort)(llist_t *, int), int sort_type,
+                   int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(p);
+    double t0 = ms_now();
+    if (p->cur) submit_batch(p);
+    wait_idle(p);
+
+    if (presort == NULL) {
+        for (int i = 0; i < p->nshards; i++) {
+            llist_splice(p->queue, p->shards[i]->shard);
+            llist_destruct(p->shards[i]->shard);
+            free(p->shards[i]);
+        }
+        p->spliced += p->nshards;
+    } else {
+        /* runs[0] is the queue itself, so it always stays on the left */
+        int nruns = p->nshards + 1;
+        llist_t **runs = (llist_t **) malloc(nruns * sizeof(llist_t *));
+        assert(runs);
+        runs[0] = p->queue;
+        for (int i = 0; i < p->nshards; i++) {
+            runs[i + 1] = p->shards[i]->shard;
+            free(p->shards[i]);
+        }
+
+        p->presort = presort;
+        p->sort_type = sort_type;
+        for (int i = 0; i < nruns; i++) submit(p, presort_task, runs[i]);
+        wait_idle(p);
+
+        /* pairwise rounds keep every merge between neighbours, so ties
+         * resolve in input order and the result is stable overall
+         */
+        merge_pair_t *pairs = (merge_pair_t *) malloc((nruns / 2 + 1) * sizeof(merge_pair_t));
+        assert(pairs);
+        while (nruns > 1) {
+            int npairs = nruns / 2;
+            for (int j = 0; j < npairs; j++) {
+                pairs[j].left = runs[2 * j];
+                pairs[j].right = runs[2 * j + 1];
+                submit(p, merge_task, &pairs[j]);
+            }
+            wait_idle(p);
+            for (int j = 0; j < npairs; j++) {
+                llist_destruct(runs[2 * j + 1]);
+                runs[j] = runs[2 * j];
+            }
+            if (nruns % 2) runs[npairs] = runs[nruns - 1];
+            nruns = npairs + nruns % 2;
+        }
+        assert(runs[0] == p->queue && p->queue->compare_fun == fcomp);
+        p->merged += p->nshards;
+        free(pairs);
+        free(runs);
+    }
+    p->nshards = 0;
+    p->sync_ms += ms_now() - t0;
+}
+
+/* ===== helpers ===== */
+
+static double ms_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+static void *worker_main(void *argp)
+{
+    pipeline_t *p = (pipeline_t *) argp;
+    pthread_mutex_lock(&p->mu);
+    for (;;) {
+        while (p->task_head == NULL && !p->stop) pthread_cond_wait(&p->work_cv, &p->mu);
+        if (p->task_head == NULL) break;
+        task_t *t = p->task_head;
+        p->task_head = t->next;
+        if (p->task_head == NULL) p->task_tail = NULL;
+        pthread_mutex_unlock(&p->mu);
+
+        t->fn(p, t->arg);
+        free(t);
+
+        pthread_mutex_lock(&p->mu);
+        p->pending--;
+        pthread_cond_broadcast(&p->done_cv);
+    }
+    pthread_mutex_unlock(&p->mu);
+    return NULL;
+}
+
+/* blocks while the pool is saturated, which bounds buffered input */
+static void submit(pipeline_t *p, void (*fn)(pipeline_t *, void *), void *arg)
+{
+    task_t *t = (task_t *) malloc(sizeof(task_t));
+    assert(t);
+    t->fn = fn;
+    t->arg = arg;
+    t->next = NULL;
+
+    pthread_mutex_lock(&p->mu);
+    while (p->pending >= PIPELINE_MAX_PENDING_PER_THREAD * p->nbuilders)
+        pthread_cond_wait(&p->done_cv, &p->mu);
+    if (p->task_tail) p->task_tail->next = t; else p->task_head = t;
+    p->task_tail = t;
+    p->pending++;
+    pthread_cond_signal(&p->work_cv);
+    pthread_mutex_unlock(&p->mu);
+}
+
+static void wait_idle(pipeline_t *p)
+{
+    pthread_mutex_lock(&p->mu);
+    while (p->pending > 0) pthread_cond_wait(&p->done_cv, &p->mu);
+    pthread_mutex_unlock(&p->mu);
+}
+
+static void submit_batch(pipeline_t *p)
+{
+    if (p->nshards == p->shard_cap) {
+        p->shard_cap = p->shard_cap ? 2 * p->shard_cap : 64;
+        p->shards = (batch_t **) realloc(p->shards, p->shard_cap * sizeof(batch_t *));
+        assert(p->shards);
+    }
+    p->shards[p->nshards++] = p->cur;
+    submit(p, build_task, p->cur);
+    p->cur = NULL;
+}
+
+/* parse exactly as lab3 does, so bad lines are skipped the same way */
+static void build_task(pipeline_t *p, void *arg)
+{
+    batch_t *b = (batch_t *) arg;
+    double t0 = ms_now();
+    llist_t *shard = llist_construct(NULL);
+    const char *line = b->text;
+    for (int i = 0; i < b->nlines; i++) {
+        int gen, ip, ts = 0;
+        if (sscanf(line, "%*s %d %d %d", &gen, &ip, &ts) >= 2) ids_append_rear_ts(shard, gen, ip, ts);
+        line += strlen(line) + 1;
+    }
+    free(b->text);
+    b->text = NULL;
+    b->shard = shard;
+    double t1 = ms_now();
+
+    pthread_mutex_lock(&p->mu);
+    p->built += llist_entries(shard);
+    p->build_busy_ms += t1 - t0;
+    pthread_mutex_unlock(&p->mu);
+}
+
+static void presort_task(pipeline_t *p, void *arg)
+{
+    p->presort((llist_t *) arg, p->sort_type);
+}
+
+static void merge_task(pipeline_t *p, void *arg)
+{
+    merge_pair_t *m = (merge_pair_t *) arg;
+    (void) p;
+    llist_merge(m->left, m->right);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
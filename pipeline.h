@@ -0,0 +1,36 @@
+/* pipeline.h
+ * Pipelined APPENDREAR ingest for lab3 -p
+ *
+ * The thread reading stdin hands APPENDREAR lines to pipeline_append_line,
+ * which packs them into batches.  A pool of builder threads parses each
+ * batch into its own shard list.  Shards are joined onto the queue in
+ * input order by pipeline_sync, which lab3 calls before any command that
+ * reads the queue, so the queue is the same as in single-threaded mode.
+ */
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "llist.h"
+
+#define PIPELINE_BATCH_LINES 4096
+
+typedef struct pipeline_tag pipeline_t;
+
+/* nbuilders threads; batch_lines APPENDREAR lines per shard */
+pipeline_t * pipeline_construct(llist_t *queue, int nbuilders, int batch_lines);
+/* waits for outstanding work and prints per-stage throughput on stderr */
+void         pipeline_destruct(pipeline_t *p);
+
+/* line must start with APPENDREAR; it is copied */
+void         pipeline_append_line(pipeline_t *p, const char *line);
+
+/* Wait until every appended line is on the queue.  With presort NULL the
+ * shards are spliced on in input order.  Otherwise presort(list,
+ * sort_type) must be a stable sort ordering by fcomp: each shard and the
+ * queue are sorted on the builder threads and then merged in input order,
+ * which leaves the queue exactly as one stable sort of the whole queue.
+ */
+void         pipeline_sync(pipeline_t *p, void (*presort)(llist_t *, int), int sort_type,
+                           int (*fcomp)(const data_t *, const data_t *));
+
+#endif
@@ -0,0 +1,160 @@
+/* recout.c
+ * ECE 2230 Fall 2025
+ * MP3 — buffered record output for PRINTQ and DUMPQ
+ *
+ * Purpose:
+ *   One buffer per stream, flushed with write(2) when the next record
+ *   might not fit.  recout_itoa writes the digits backwards into a small
+ *   scratch array two at a time, then copies them out; negative values
+ *   go through unsigned so LONG_MIN needs no special case.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <unistd.h>
+
+#include "recout.h"
+
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* ===== private helpers ===== */
+static void reserve(recout_t *o, size_t bytes);
+static void put(recout_t *o, const char *s, size_t n);
+
+recout_t *recout_open(int fd, size_t cap)
+{
+    recout_t *o = (recout_t *) malloc(sizeof(recout_t));
+    assert(o);
+    o->fd = fd;
+    o->cap = cap ? cap : RECOUT_BUFSIZE;
+    assert(o->cap >= RECOUT_LINE_MAX);
+    o->buf = (char *) malloc(o->cap);
+    assert(o->buf);
+    o->len = 0;
+    o->records = 0;
+    o->failed = 0;
+    return o;
+}
+
+int recout_close(recout_t *o)
+{
+    assert(o);
+    recout_flush(o);
+    int ret = o->failed ? -1 : 0;
+    free(o->buf);
+    free(o);
+    return ret;
+}
+
+void recout_flush(recout_t *o)
+{
+    assert(o);
+    size_t done = 0;
+    while (done < o->len && !o->failed) {
+        ssize_t w = write(o->fd, o->buf + done, o->len - done);
+        if (w > 0)                      done += w;
+        else if (w < 0 && errno == EINTR) continue;
+        else                            o->failed = 1;
+    }
+    o->len = 0;
+}
+
+void recout_str(recout_t *o, const char *s)
+{
+    assert(o && s);
+    put(o, s, strlen(s));
+}
+
+void recout_int(recout_t *o, long v)
+{
+    assert(o);
+    reserve(o, 20);
+    o->len += recout_itoa(o->buf + o->len, v);
+}
+
+void recout_text(recout_t *o, long index, const data_t *rec)
+{
+    assert(o && rec);
+    reserve(o, RECOUT_LINE_MAX);
+    char *p = o->buf + o->len;
+#define LIT(s) (memcpy(p, s, sizeof(s) - 1), p += sizeof(s) - 1)
+    p += recout_itoa(p, index);
+    LIT(": [");
+    p += recout_itoa(p, rec->generator_id);
+    *p++ = ':';
+    p += recout_itoa(p, rec->signature_id);
+    *p++ = ':';
+    p += recout_itoa(p, rec->revision_id);
+    LIT("] (gen, sig, rev): Dest IP: ");
+    p += recout_itoa(p, rec->dest_ip_addr);
+    LIT(", Src: ");
+    p += recout_itoa(p, rec->src_ip_addr);
+    LIT(", Dest port: ");
+    p += recout_itoa(p, rec->dest_port_num);
+    LIT(", Src: ");
+    p += recout_itoa(p, rec->src_port_num);
+    LIT(", Time: ");
+    p += recout_itoa(p, rec->timestamp);
+    *p++ = '\n';
+#undef LIT
+    o->len = p - o->buf;
+    o->records++;
+}
+
+void recout_binary(recout_t *o, const data_t *rec)
+{
+    assert(o && rec);
+    put(o, (const char *) rec, sizeof(data_t));
+    o->records++;
+}
+
+int recout_itoa(char *dst, long v)
+{
+    char tmp[20];
+    char *p = tmp + sizeof(tmp);
+    unsigned long u = (v < 0) ? 0ul - (unsigned long) v : (unsigned long) v;
+    while (u >= 100) {
+        unsigned long pair = (u % 100) * 2;
+        u /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if (u >= 10) {
+        *--p = digit_pairs[u * 2 + 1];
+        *--p = digit_pairs[u * 2];
+    } else {
+        *--p = (char) ('0' + u);
+    }
+    if (v < 0) *--p = '-';
+    int n = (int) (tmp + sizeof(tmp) - p);
+    memcpy(dst, p, n);
+    return n;
+}
+
+/* ===== helpers ===== */
+
+/* make room for bytes more, flushing if they would not fit */
+static void reserve(recout_t *o, size_t bytes)
+{
+    assert(bytes <= o->cap);
+    if (o->len + bytes > o->cap) recout_flush(o);
+}
+
+static void put(recout_t *o, const char *s, size_t n)
+{
+    while (n > 0) {
+        if (o->len == o->cap) recout_flush(o);
+        size_t k = o->cap - o->len;
+        if (k > n) k = n;
+        memcpy(o->buf + o->len, s, k);
+        o->len += k;
+        s += k;
+        n -= k;
+    }
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
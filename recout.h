@@ -0,0 +1,51 @@
+/* recout.h
+ * Buffered record output for PRINTQ and queue dumps
+ *
+ * Formats alert_t records into one reusable buffer and hands it to
+ * write(2) only when full, so dumping a large queue costs a few syscalls
+ * instead of three printf calls per record.  Integers are formatted two
+ * digits at a time from a lookup table.  Text lines match
+ * ids_print_alert_rec exactly.
+ *
+ * A binary dump is the records in list order as packed data_t (8 int32
+ * fields, host byte order) with no header, readable as an int32 array
+ * of n x 8.  llist_save's snapshot adds a header and is meant for
+ * llist_load; this format is meant for other tools.
+ *
+ * The caller must fflush any stdio stream on the same descriptor before
+ * recout writes to it.
+ */
+#ifndef RECOUT_H
+#define RECOUT_H
+
+#include <stddef.h>
+#include "datatypes.h"
+
+#define RECOUT_BUFSIZE   (1 << 16)
+#define RECOUT_LINE_MAX  256     /* longest text line recout_text writes */
+
+typedef struct recout_tag {
+    int fd;
+    char *buf;
+    size_t len;
+    size_t cap;
+    long records;       /* records written so far */
+    int failed;         /* a write(2) failed; later output is dropped */
+} recout_t;
+
+/* buffer output for fd; cap 0 means RECOUT_BUFSIZE */
+recout_t * recout_open(int fd, size_t cap);
+/* flush, free, and return 0, or -1 if any write failed (fd stays open) */
+int        recout_close(recout_t *o);
+void       recout_flush(recout_t *o);
+
+void       recout_str(recout_t *o, const char *s);
+void       recout_int(recout_t *o, long v);
+/* "<index>: [gen:sig:rev] (gen, sig, rev): Dest IP: ... Time: t\n" */
+void       recout_text(recout_t *o, long index, const data_t *rec);
+void       recout_binary(recout_t *o, const data_t *rec);
+
+/* decimal digits of v at dst, no terminator; returns the length (<= 20) */
+int        recout_itoa(char *dst, long v);
+
+#endif
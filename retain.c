@@ -0,0 +1,170 @@
+/* retain.c
+ * ECE 2230 Fall 2025
+ * MP3 — timestamp-windowed retention
+ *
+ * Purpose:
+ *   A ring of buckets in ascending bucket number (timestamp / width).  A
+ *   feed with rising timestamps only ever appends to the newest bucket or
+ *   opens one after it, and expiry only pops from the oldest end, so both
+ *   are O(1) per alert.  Late arrivals binary-search for their bucket.
+ *   Popped buckets keep their node arrays for reuse, so a steady feed
+ *   stops allocating once the ring has grown to the window.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "retain.h"
+#include "memacct.h"
+
+#define RETAIN_INITIAL_BUCKETS 16
+#define RETAIN_INITIAL_NODES   64
+
+typedef struct retain_bucket_tag {
+    long number;            /* floor(timestamp / width) */
+    llist_elem_t **nodes;
+    int count;
+    int cap;
+} retain_bucket_t;
+
+struct retain_tag {
+    int window;
+    int width;
+    int newest;
+    retain_bucket_t *ring;  /* live buckets are ring[(head + i) % cap], i < nbuckets */
+    int cap;
+    int head;
+    int nbuckets;
+};
+
+/* ===== private helpers ===== */
+static long floor_div(long a, long b);
+static retain_bucket_t *slot(retain_t *r, int i);
+static void ring_grow(retain_t *r);
+static retain_bucket_t *open_bucket(retain_t *r, int i, long number);
+static retain_bucket_t *find_bucket(retain_t *r, long number);
+
+retain_t *retain_construct(int window, int width)
+{
+    assert(window > 0 && width > 0);
+    retain_t *r = (retain_t *) calloc(1, sizeof(retain_t));
+    assert(r);
+    r->window = window;
+    r->width = width;
+    return r;
+}
+
+void retain_destruct(retain_t *r)
+{
+    assert(r);
+    for (int i = 0; i < r->cap; i++) free(r->ring[i].nodes);
+    free(r->ring);
+    free(r);
+}
+
+void retain_track(retain_t *r, llist_elem_t *elem)
+{
+    assert(r && elem && elem->data_ptr);
+    int ts = elem->data_ptr->timestamp;
+    if (ts > r->newest) r->newest = ts;
+
+    retain_bucket_t *b = find_bucket(r, floor_div(ts, r->width));
+    if (b->count == b->cap) {
+        b->cap = b->cap ? 2 * b->cap : RETAIN_INITIAL_NODES;
+        b->nodes = (llist_elem_t **) realloc(b->nodes, b->cap * sizeof(llist_elem_t *));
+        assert(b->nodes);
+    }
+    b->nodes[b->count++] = elem;
+}
+
+void retain_track_list(retain_t *r, llist_t *list_ptr)
+{
+    assert(r && list_ptr);
+    for (llist_elem_t *e = list_ptr->ll_front; e; e = e->ll_next) retain_track(r, e);
+}
+
+int retain_expire(retain_t *r, llist_t *list_ptr, int now)
+{
+    assert(r && list_ptr);
+    long cut = floor_div((long) now - r->window, r->width);
+    int expired = 0;
+    while (r->nbuckets > 0 && slot(r, 0)->number < cut) {
+        retain_bucket_t *b = slot(r, 0);
+        for (int i = 0; i < b->count; i++)
+            memacct_free(MEMACCT_RECORD, llist_remove_elem(list_ptr, b->nodes[i]), sizeof(data_t));
+        expired += b->count;
+        b->count = 0;
+        r->head = (r->head + 1) % r->cap;
+        r->nbuckets--;
+    }
+    return expired;
+}
+
+int retain_newest(const retain_t *r)
+{
+    assert(r);
+    return r->newest;
+}
+
+int retain_is_expired(int timestamp, int now, int window, int width)
+{
+    assert(window > 0 && width > 0);
+    return floor_div(timestamp, width) < floor_div((long) now - window, width);
+}
+
+/* ===== helpers ===== */
+
+static long floor_div(long a, long b)
+{
+    long q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+static retain_bucket_t *slot(retain_t *r, int i)
+{
+    return &r->ring[(r->head + i) % r->cap];
+}
+
+/* double the ring, unrolled so head is 0; spare slots keep their arrays */
+static void ring_grow(retain_t *r)
+{
+    int cap = r->cap ? 2 * r->cap : RETAIN_INITIAL_BUCKETS;
+    retain_bucket_t *ring = (retain_bucket_t *) calloc(cap, sizeof(retain_bucket_t));
+    assert(ring);
+    for (int i = 0; i < r->cap; i++) ring[i] = *slot(r, i);
+    free(r->ring);
+    r->ring = ring;
+    r->cap = cap;
+    r->head = 0;
+}
+
+/* make an empty bucket the i-th live one, shifting later buckets up */
+static retain_bucket_t *open_bucket(retain_t *r, int i, long number)
+{
+    if (r->nbuckets == r->cap) ring_grow(r);
+    retain_bucket_t spare = *slot(r, r->nbuckets);
+    for (int j = r->nbuckets; j > i; j--) *slot(r, j) = *slot(r, j - 1);
+    spare.number = number;
+    spare.count = 0;
+    *slot(r, i) = spare;
+    r->nbuckets++;
+    return slot(r, i);
+}
+
+static retain_bucket_t *find_bucket(retain_t *r, long number)
+{
+    if (r->nbuckets == 0 || slot(r, r->nbuckets - 1)->number < number)
+        return open_bucket(r, r->nbuckets, number);
+    if (slot(r, r->nbuckets - 1)->number == number) return slot(r, r->nbuckets - 1);
+
+    /* late arrival: first bucket numbered at least number */
+    int lo = 0, hi = r->nbuckets - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (slot(r, mid)->number < number) lo = mid + 1; else hi = mid;
+    }
+    if (slot(r, lo)->number == number) return slot(r, lo);
+    return open_bucket(r, lo, number);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,40 @@
+/* retain.h
+ * Timestamp-windowed retention for lab3's WINDOW / EXPIRE
+ *
+ * Tracks a list's nodes in buckets of `width` seconds by alert timestamp,
+ * oldest bucket first.  retain_expire unlinks every node in the buckets
+ * that have fallen out of the window, so it costs O(expired) and never
+ * walks the kept alerts.  Expiry is bucket-granular: an alert goes once
+ * its whole bucket is older than now - window (exact for width 1).
+ *
+ * The buckets hold node pointers.  Every tracked node must stay in the
+ * list passed to retain_expire, and nothing may move it (llist_compact)
+ * or remove it behind retain's back; after a wholesale change such as a
+ * load, destruct and track the list again.
+ */
+#ifndef RETAIN_H
+#define RETAIN_H
+
+#include "llist.h"
+
+typedef struct retain_tag retain_t;
+
+retain_t * retain_construct(int window, int width);
+void       retain_destruct(retain_t *r);
+
+/* add one node (filed by its record's timestamp), or every node of L */
+void       retain_track(retain_t *r, llist_elem_t *elem);
+void       retain_track_list(retain_t *r, llist_t *list_ptr);
+
+/* remove and free every tracked alert older than now - window from
+ * list_ptr; returns how many went
+ */
+int        retain_expire(retain_t *r, llist_t *list_ptr, int now);
+
+/* latest timestamp tracked so far (0 before any) */
+int        retain_newest(const retain_t *r);
+
+/* the expiry rule on its own, for stores without nodes */
+int        retain_is_expired(int timestamp, int now, int window, int width);
+
+#endif
@@ -9,7 +9,7 @@
 # MP3 place in student directory
 if [ ! -f ./geninput ]; then
     if [ -f ./geninput.c ]; then
-        gcc geninput.c -o geninput
+        gcc geninput.c workload.c -o geninput -lm
     else
         echo "geninput.c file not found! Check why not in repository!"
         exit 1
@@ -31,9 +31,58 @@ seed=09162025
 ./geninput 20 1 5 gen $seed | ./lab3 > gradingout_t51_qsort
 ./geninput 20 2 5 gen $seed | ./lab3 > gradingout_t52_qsort
 ./geninput 20 3 5 gen $seed | ./lab3 > gradingout_t53_qsort
+./geninput 20 2 5 gen $seed | ./lab3 -p 2 -b 3 > gradingout_t54_pipe 2> /dev/null
+./geninput 20 1 6 gen $seed | ./lab3 > gradingout_t61_stable
+./geninput 20 2 6 gen $seed | ./lab3 > gradingout_t62_stable
+./geninput 20 3 6 gen $seed | ./lab3 > gradingout_t63_stable
+./geninput 20 1 6 gen $seed | ./lab3 -p 3 -b 4 > gradingout_t64_pipe 2> /dev/null
+./geninput 20 1 6 gen $seed | ./lab3 -c > gradingout_t71_cols
+./geninput 20 1 6 ip $seed | ./lab3 -c > gradingout_t72_cols
+./geninput 20 1 8 ip $seed | ./lab3 > gradingout_t81_pdq
+./geninput 20 2 8 ip $seed | ./lab3 > gradingout_t82_pdq
+./geninput 20 3 8 ip $seed | ./lab3 > gradingout_t83_pdq
+./geninput 20 fewunique 1 ip $seed | ./lab3 > gradingout_t14_fewunique
+./geninput 20 sawtooth 4 ip $seed | ./lab3 > gradingout_t44_sawtooth
+./geninput 20 zipf 8 gen $seed | ./lab3 > gradingout_t84_zipf
 ./lab3 < ./tests/t01insert  > gradingout_t01insert
 ./lab3 < ./tests/t02recsel > gradingout_t02recsel
 ./lab3 < ./tests/t03itersel > gradingout_t03itersel
 ./lab3 < ./tests/t04merge > gradingout_t04merge
 ./lab3 < ./tests/t05qsort > gradingout_t05qsort
+./lab3 < ./tests/t06stable > gradingout_t06stable
+./lab3 -p 2 -b 3 < ./tests/t06stable > gradingout_t06pipe 2> /dev/null
+./lab3 < ./tests/t07simd > gradingout_t07simd
+SIMDSORT_ISA=sse4.2 ./lab3 < ./tests/t07simd > gradingout_t07simd_sse
+SIMDSORT_ISA=scalar ./lab3 < ./tests/t07simd > gradingout_t07simd_scalar
+./lab3 < ./tests/t08pdq > gradingout_t08pdq
+./lab3 < ./tests/t09async > gradingout_t09async
+./lab3 -c < ./tests/t09async > gradingout_t09async_cols
+./lab3 -p 2 -b 2 < ./tests/t09async > gradingout_t09async_pipe 2> /dev/null
+./lab3 < ./tests/t10persist > gradingout_t10persist
+./lab3 -c < ./tests/t10persist > gradingout_t10persist_cols
+./lab3 -p 2 -b 3 < ./tests/t10persist > gradingout_t10persist_pipe 2> /dev/null
 
+./lab3 < ./tests/t11extsort > gradingout_t11extsort
+./extsort -m 1K -k 2 < ./tests/t11extsort > gradingout_t11extsort_ext 2> /dev/null
+./extsort -m 1K -s ip < ./tests/t11extsort > gradingout_t11extsort_spill 2> /dev/null
+./lab3 < ./tests/t12window > gradingout_t12window
+./lab3 -c < ./tests/t12window > gradingout_t12window_cols
+./lab3 -p 2 -b 2 < ./tests/t12window > gradingout_t12window_pipe 2> /dev/null
+./lab3 < ./tests/t13hist > gradingout_t13hist
+./lab3 -H < ./tests/t13hist | awk -F'\t' 'NF == 7 { print $1 "\t" $2; next } { print }' > gradingout_t13hist_counts
+./lab3 -M < ./tests/t14mem > gradingout_t14mem
+./lab3 < ./tests/t15dual > gradingout_t15dual
+./lab3 -d < ./tests/t15dual > gradingout_t15dual_d
+./lab3 -d -p 2 -b 2 < ./tests/t15dual > gradingout_t15dual_pipe 2> /dev/null
+./lab3 < ./tests/t16dump > gradingout_t16dump 2> /dev/null
+od -An -td4 -w32 -v gradingout_t16dump.bin >> gradingout_t16dump
+./lab3 -c < ./tests/t16dump > gradingout_t16dump_cols 2> /dev/null
+od -An -td4 -w32 -v gradingout_t16dump.bin >> gradingout_t16dump_cols
+./lab3 < ./tests/t17benchall > gradingout_t17benchall
+./lab3 -d < ./tests/t17benchall > gradingout_t17benchall_d
+./lab3 < ./tests/t18cold > gradingout_t18cold
+./lab3 -d < ./tests/t18cold > gradingout_t18cold_d
+./lab3 -p 2 -b 16 < ./tests/t18cold > gradingout_t18cold_pipe 2> /dev/null
+./listcheck ullist > gradingout_t19ullist
+./listcheck ilist > gradingout_t20ilist
+./listcheck heap > gradingout_t21heap
@@ -0,0 +1,344 @@
+/* simdsort.c
+ * ECE 2230 Fall 2025
+ * MP3 — Sorting-network and bitonic-merge kernels
+ *
+ * Purpose:
+ *   Bottom-up merge sort of packed int64 keys.  Blocks are sorted in
+ *   registers by a sorting network, then runs are merged with a bitonic
+ *   merge kernel that emits four values per step.
+ *
+ *   kernel set   block   merge step
+ *   avx2         16      4+4 in two __m256i
+ *   sse4.2        8      4+4 in four __m128i
+ *   scalar        8      branchless one-at-a-time merge
+ *
+ * Notes:
+ *   The vector kernels are compiled with per-function target attributes,
+ *   so the rest of the program needs no -mavx2 and still runs on CPUs
+ *   without the extensions.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <immintrin.h>
+#include "simdsort.h"
+
+struct simdsort_kernels {
+    const char *name;
+    size_t block;
+    void (*block_sort)(int64_t *a);
+    void (*merge)(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out);
+};
+
+static const struct simdsort_kernels *pick_kernels(void);
+
+/* ===== scalar kernels ===== */
+
+#define CSWAP(x, y) do {                          \
+        int64_t lo_ = (x) < (y) ? (x) : (y);      \
+        int64_t hi_ = (x) < (y) ? (y) : (x);      \
+        (x) = lo_; (y) = hi_;                     \
+    } while (0)
+
+static void insertion_i64(int64_t *a, size_t n)
+{
+    for (size_t i = 1; i < n; i++) {
+        int64_t x = a[i];
+        size_t j = i;
+        while (j > 0 && a[j-1] > x) { a[j] = a[j-1]; j--; }
+        a[j] = x;
+    }
+}
+
+/* 19-comparator network for 8 values */
+static void scalar_block8(int64_t *a)
+{
+    CSWAP(a[0], a[2]); CSWAP(a[1], a[3]); CSWAP(a[4], a[6]); CSWAP(a[5], a[7]);
+    CSWAP(a[0], a[4]); CSWAP(a[1], a[5]); CSWAP(a[2], a[6]); CSWAP(a[3], a[7]);
+    CSWAP(a[0], a[1]); CSWAP(a[2], a[3]); CSWAP(a[4], a[5]); CSWAP(a[6], a[7]);
+    CSWAP(a[2], a[4]); CSWAP(a[3], a[5]);
+    CSWAP(a[1], a[4]); CSWAP(a[3], a[6]);
+    CSWAP(a[1], a[2]); CSWAP(a[3], a[4]); CSWAP(a[5], a[6]);
+}
+
+static void scalar_merge(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out)
+{
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        int64_t x = a[i], y = b[j];
+        int take_b = y < x;
+        out[k++] = take_b ? y : x;
+        j += take_b;
+        i += !take_b;
+    }
+    memcpy(out + k, a + i, (na - i) * sizeof(int64_t));
+    memcpy(out + k + (na - i), b + j, (nb - j) * sizeof(int64_t));
+}
+
+/* finish a vector merge: four pending values in c[], plus both run tails */
+static void merge_tail(const int64_t *c, const int64_t *a, size_t na,
+                       const int64_t *b, size_t nb, int64_t *out)
+{
+    size_t ci = 0, i = 0, j = 0, k = 0;
+    while (ci < 4) {
+        if (i < na && a[i] < c[ci] && (j >= nb || a[i] < b[j])) out[k++] = a[i++];
+        else if (j < nb && b[j] < c[ci])                         out[k++] = b[j++];
+        else                                                      out[k++] = c[ci++];
+    }
+    scalar_merge(a + i, na - i, b + j, nb - j, out + k);
+}
+
+/* ===== AVX2 kernels (4 x int64 per register) ===== */
+
+#define AVX2 __attribute__((target("avx2")))
+#define AVX2_INLINE __attribute__((target("avx2"), always_inline))
+
+AVX2_INLINE static inline void v4_cswap(__m256i *a, __m256i *b)
+{
+    __m256i gt = _mm256_cmpgt_epi64(*a, *b);
+    __m256i lo = _mm256_blendv_epi8(*a, *b, gt);
+    *b = _mm256_blendv_epi8(*b, *a, gt);
+    *a = lo;
+}
+
+/* bitonic 4 -> sorted 4 */
+AVX2_INLINE static inline __m256i v4_clean(__m256i v)
+{
+    __m256i t = _mm256_permute4x64_epi64(v, 0x4E);   /* lanes 2,3,0,1 */
+    __m256i lo = v;
+    v4_cswap(&lo, &t);
+    v = _mm256_blend_epi32(lo, t, 0xF0);
+    t = _mm256_permute4x64_epi64(v, 0xB1);           /* lanes 1,0,3,2 */
+    lo = v;
+    v4_cswap(&lo, &t);
+    return _mm256_blend_epi32(lo, t, 0xCC);
+}
+
+/* two sorted 4s -> *a holds the low 4, *b the high 4, both sorted */
+AVX2_INLINE static inline void v4_merge(__m256i *a, __m256i *b)
+{
+    *b = _mm256_permute4x64_epi64(*b, 0x1B);         /* reverse */
+    v4_cswap(a, b);
+    *a = v4_clean(*a);
+    *b = v4_clean(*b);
+}
+
+AVX2 static void avx2_block16(int64_t *a)
+{
+    __m256i r0 = _mm256_loadu_si256((const __m256i *) (a + 0));
+    __m256i r1 = _mm256_loadu_si256((const __m256i *) (a + 4));
+    __m256i r2 = _mm256_loadu_si256((const __m256i *) (a + 8));
+    __m256i r3 = _mm256_loadu_si256((const __m256i *) (a + 12));
+
+    /* sort the four columns with a 5-comparator network */
+    v4_cswap(&r0, &r1); v4_cswap(&r2, &r3);
+    v4_cswap(&r0, &r2); v4_cswap(&r1, &r3);
+    v4_cswap(&r1, &r2);
+
+    /* transpose so each register holds one sorted column */
+    __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+    __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+    __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+    __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+    __m256i c0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+    __m256i c1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+    __m256i c2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+    __m256i c3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+
+    /* 4+4 -> 8 twice, then 8+8 -> 16 */
+    v4_merge(&c0, &c1);
+    v4_merge(&c2, &c3);
+    __m256i h0 = _mm256_permute4x64_epi64(c3, 0x1B);
+    __m256i h1 = _mm256_permute4x64_epi64(c2, 0x1B);
+    v4_cswap(&c0, &h0);
+    v4_cswap(&c1, &h1);
+    v4_cswap(&c0, &c1);
+    v4_cswap(&h0, &h1);
+
+    _mm256_storeu_si256((__m256i *) (a + 0), v4_clean(c0));
+    _mm256_storeu_si256((__m256i *) (a + 4), v4_clean(c1));
+    _mm256_storeu_si256((__m256i *) (a + 8), v4_clean(h0));
+    _mm256_storeu_si256((__m256i *) (a + 12), v4_clean(h1));
+}
+
+AVX2 static void avx2_merge(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out)
+{
+    if (na < 4 || nb < 4) { scalar_merge(a, na, b, nb, out); return; }
+
+    size_t i = 4, j = 0, k = 0;
+    __m256i cur = _mm256_loadu_si256((const __m256i *) a);
+    for (;;) {
+        __m256i nxt;
+        int from_a = (j >= nb) || (i < na && a[i] < b[j]);
+        if (from_a) {
+            if (i + 4 > na) break;
+            nxt = _mm256_loadu_si256((const __m256i *) (a + i));
+            i += 4;
+        } else {
+            if (j + 4 > nb) break;
+            nxt = _mm256_loadu_si256((const __m256i *) (b + j));
+            j += 4;
+        }
+        v4_merge(&cur, &nxt);
+        _mm256_storeu_si256((__m256i *) (out + k), cur);
+        k += 4;
+        cur = nxt;
+    }
+    int64_t pending[4];
+    _mm256_storeu_si256((__m256i *) pending, cur);
+    merge_tail(pending, a + i, na - i, b + j, nb - j, out + k);
+}
+
+/* ===== SSE4.2 kernels (2 x int64 per register) ===== */
+
+#define SSE42 __attribute__((target("sse4.2")))
+#define SSE42_INLINE __attribute__((target("sse4.2"), always_inline))
+
+SSE42_INLINE static inline void v2_cswap(__m128i *a, __m128i *b)
+{
+    __m128i gt = _mm_cmpgt_epi64(*a, *b);
+    __m128i lo = _mm_blendv_epi8(*a, *b, gt);
+    *b = _mm_blendv_epi8(*b, *a, gt);
+    *a = lo;
+}
+
+SSE42_INLINE static inline __m128i v2_rev(__m128i v)
+{
+    return _mm_shuffle_epi32(v, 0x4E);
+}
+
+/* bitonic 4 held in (x0, x1) -> sorted */
+SSE42_INLINE static inline void v2_clean4(__m128i *x0, __m128i *x1)
+{
+    v2_cswap(x0, x1);
+    __m128i t0 = v2_rev(*x0), t1 = v2_rev(*x1);
+    __m128i lo0 = *x0, lo1 = *x1;
+    v2_cswap(&lo0, &t0);
+    v2_cswap(&lo1, &t1);
+    *x0 = _mm_unpacklo_epi64(lo0, t0);
+    *x1 = _mm_unpacklo_epi64(lo1, t1);
+}
+
+/* sorted (a0,a1) and (b0,b1) -> low 4 in (a0,a1), high 4 in (b0,b1) */
+SSE42_INLINE static inline void v2_merge4(__m128i *a0, __m128i *a1, __m128i *b0, __m128i *b1)
+{
+    __m128i r0 = v2_rev(*b1), r1 = v2_rev(*b0);
+    v2_cswap(a0, &r0);
+    v2_cswap(a1, &r1);
+    v2_clean4(a0, a1);
+    v2_clean4(&r0, &r1);
+    *b0 = r0;
+    *b1 = r1;
+}
+
+SSE42 static void sse42_block8(int64_t *a)
+{
+    __m128i r0 = _mm_loadu_si128((const __m128i *) (a + 0));
+    __m128i r1 = _mm_loadu_si128((const __m128i *) (a + 2));
+    __m128i r2 = _mm_loadu_si128((const __m128i *) (a + 4));
+    __m128i r3 = _mm_loadu_si128((const __m128i *) (a + 6));
+
+    v2_cswap(&r0, &r1); v2_cswap(&r2, &r3);
+    v2_cswap(&r0, &r2); v2_cswap(&r1, &r3);
+    v2_cswap(&r1, &r2);
+
+    /* lane 0 of r0..r3 and lane 1 of r0..r3 are now sorted runs of 4 */
+    __m128i a0 = _mm_unpacklo_epi64(r0, r1), a1 = _mm_unpacklo_epi64(r2, r3);
+    __m128i b0 = _mm_unpackhi_epi64(r0, r1), b1 = _mm_unpackhi_epi64(r2, r3);
+    v2_merge4(&a0, &a1, &b0, &b1);
+
+    _mm_storeu_si128((__m128i *) (a + 0), a0);
+    _mm_storeu_si128((__m128i *) (a + 2), a1);
+    _mm_storeu_si128((__m128i *) (a + 4), b0);
+    _mm_storeu_si128((__m128i *) (a + 6), b1);
+}
+
+SSE42 static void sse42_merge(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out)
+{
+    if (na < 4 || nb < 4) { scalar_merge(a, na, b, nb, out); return; }
+
+    size_t i = 4, j = 0, k = 0;
+    __m128i c0 = _mm_loadu_si128((const __m128i *) a);
+    __m128i c1 = _mm_loadu_si128((const __m128i *) (a + 2));
+    for (;;) {
+        const int64_t *src;
+        int from_a = (j >= nb) || (i < na && a[i] < b[j]);
+        if (from_a) {
+            if (i + 4 > na) break;
+            src = a + i;
+            i += 4;
+        } else {
+            if (j + 4 > nb) break;
+            src = b + j;
+            j += 4;
+        }
+        __m128i n0 = _mm_loadu_si128((const __m128i *) src);
+        __m128i n1 = _mm_loadu_si128((const __m128i *) (src + 2));
+        v2_merge4(&c0, &c1, &n0, &n1);
+        _mm_storeu_si128((__m128i *) (out + k), c0);
+        _mm_storeu_si128((__m128i *) (out + k + 2), c1);
+        k += 4;
+        c0 = n0;
+        c1 = n1;
+    }
+    int64_t pending[4];
+    _mm_storeu_si128((__m128i *) pending, c0);
+    _mm_storeu_si128((__m128i *) (pending + 2), c1);
+    merge_tail(pending, a + i, na - i, b + j, nb - j, out + k);
+}
+
+/* ===== driver ===== */
+
+static const struct simdsort_kernels kernel_sets[] = {
+    { "avx2",   16, avx2_block16,  avx2_merge },
+    { "sse4.2",  8, sse42_block8,  sse42_merge },
+    { "scalar",  8, scalar_block8, scalar_merge },
+};
+
+static const struct simdsort_kernels *pick_kernels(void)
+{
+    static const struct simdsort_kernels *chosen = NULL;
+    if (chosen) return chosen;
+
+    __builtin_cpu_init();
+    int first = 2;
+    if (__builtin_cpu_supports("sse4.2")) first = 1;
+    if (__builtin_cpu_supports("avx2"))   first = 0;
+
+    const char *want = getenv("SIMDSORT_ISA");
+    if (want) {
+        for (int i = first; i < 3; i++) {
+            if (strcmp(want, kernel_sets[i].name) == 0) { first = i; break; }
+        }
+    }
+    chosen = &kernel_sets[first];
+    return chosen;
+}
+
+const char *simdsort_isa(void)
+{
+    return pick_kernels()->name;
+}
+
+void simdsort_i64(int64_t *a, int64_t *tmp, size_t n)
+{
+    const struct simdsort_kernels *K = pick_kernels();
+    size_t lo;
+
+    for (lo = 0; lo + K->block <= n; lo += K->block) K->block_sort(a + lo);
+    if (lo < n) insertion_i64(a + lo, n - lo);
+
+    int64_t *src = a, *dst = tmp;
+    for (size_t width = K->block; width < n; width *= 2) {
+        for (lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = (lo + width < n) ? lo + width : n;
+            size_t hi = (lo + 2 * width < n) ? lo + 2 * width : n;
+            K->merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+        }
+        int64_t *t = src; src = dst; dst = t;
+    }
+    if (src != a) memcpy(a, src, n * sizeof(int64_t));
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,28 @@
+/* simdsort.h
+ * Vectorized sort kernels for packed 64-bit keys
+ *
+ * Values are sorted as signed 64-bit integers.  Callers pack a 32-bit
+ * sort key into the high half and a 32-bit element index into the low
+ * half (see SIMDSORT_PACK), which makes every value unique and the sort
+ * stable with respect to the index.
+ *
+ * The kernel set (AVX2, SSE4.2 or scalar) is chosen once at run time
+ * from CPUID.  Setting SIMDSORT_ISA=avx2|sse4.2|scalar in the
+ * environment forces a lower (or equal) kernel set, for testing.
+ */
+#ifndef SIMDSORT_H
+#define SIMDSORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SIMDSORT_PACK(key, idx)  ((int64_t) (((uint64_t) (uint32_t) (key) << 32) | (uint32_t) (idx)))
+#define SIMDSORT_INDEX(v)        ((uint32_t) (v))
+
+/* sort a[0..n) ascending; tmp must have room for n values */
+void        simdsort_i64(int64_t *a, int64_t *tmp, size_t n);
+
+/* name of the kernel set in use: "avx2", "sse4.2" or "scalar" */
+const char *simdsort_isa(void);
+
+#endif
@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# sortcompare.sh — compare sort types on every geninput list type
+# Usage:
+#   ./sortcompare.sh                          # qsort_r (5) vs pdqsort (8)
+#   ./sortcompare.sh sorts=5,6,7,8 sizes=100000,500000 seeds=1,2,3
+# Output: CSV "size,listtype,field,sort_type,seed,ms" on stdout
+set -euo pipefail
+
+SIZES=(100000 500000)
+SORTS=(5 8)
+LISTTYPES=(1 2 3)        # 1:random  2:ascending  3:descending
+FIELDS=(gen ip)
+SEEDS=(111 222 333)
+
+for arg in "$@"; do
+  case "$arg" in
+    sizes=*)     IFS=',' read -r -a SIZES <<<"${arg#*=}" ;;
+    sorts=*)     IFS=',' read -r -a SORTS <<<"${arg#*=}" ;;
+    listtypes=*) IFS=',' read -r -a LISTTYPES <<<"${arg#*=}" ;;
+    fields=*)    IFS=',' read -r -a FIELDS <<<"${arg#*=}" ;;
+    seeds=*)     IFS=',' read -r -a SEEDS <<<"${arg#*=}" ;;
+    *) echo "sortcompare: ignoring '$arg'" >&2 ;;
+  esac
+done
+
+[ -x ./lab3 ] || make lab3 >&2
+[ -x ./geninput ] || make geninput >&2
+
+echo "size,listtype,field,sort_type,seed,ms"
+for n in "${SIZES[@]}"; do
+  for lt in "${LISTTYPES[@]}"; do
+    for f in "${FIELDS[@]}"; do
+      for s in "${SORTS[@]}"; do
+        for seed in "${SEEDS[@]}"; do
+          line="$(./geninput "$n" "$lt" "$s" "$f" "$seed" | ./lab3 | awk -F'\t' 'NF==3 {print $2}')"
+          echo "${n},${lt},${f},${s},${seed},${line}"
+        done
+      done
+    done
+  done
+done
@@ -0,0 +1,386 @@
+/* ullist.c
+ * ECE 2230 Fall 2025
+ * MP3 — Unrolled Linked List ADT
+ *
+ * Purpose:
+ *   Alternative backend for the list ADT.  Each node stores up to
+ *   ULLIST_BLOCK_CAP data pointers, so per-element overhead is about 10
+ *   bytes instead of a 24-byte node plus malloc header, and a traversal
+ *   touches one node per block of elements.
+ *
+ * Notes:
+ *   - A full block is split in half on insert; a block that drops below
+ *     half full on remove is merged into its successor when both fit.
+ *   - ullist_sort() insertion sorts each block in place and merges the
+ *     blocks bottom-up as runs, writing each merge into full blocks (the
+ *     last possibly partial) and reusing input blocks as they drain, so it
+ *     needs no array of the whole list and at most one extra block.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "ullist.h"
+
+/* Private sorted-state flags (same values as llist.c) */
+#define ULLIST_SORTED    989898
+#define ULLIST_UNSORTED  -898989
+
+/* pending runs in ullist_sort: level i holds 2^i blocks' worth */
+#define ULLIST_MERGE_LEVELS 32
+
+/* ===== private helpers ===== */
+static ullist_block_t *block_new(void);
+static void block_link_after(ullist_t *L, ullist_block_t *prev, ullist_block_t *blk);
+static void block_unlink(ullist_t *L, ullist_block_t *blk);
+static ullist_block_t *locate(ullist_t *L, int pos_index, int *offset);
+static void insert_at(ullist_t *L, ullist_block_t *blk, int off, data_t *elem_ptr);
+static void block_sort(ullist_block_t *blk, int (*fcomp)(const data_t *, const data_t *));
+static ullist_block_t *merge_runs(ullist_block_t *a, ullist_block_t *b,
+                                  int (*fcomp)(const data_t *, const data_t *),
+                                  ullist_block_t **spare);
+
+/* ===== core ADT functions ===== */
+
+data_t *ullist_access(ullist_t *list_ptr, int pos_index)
+{
+    assert(list_ptr);
+    if (list_ptr->ul_entry_count == 0) return NULL;
+
+    if (pos_index == LLPOSITION_FRONT || pos_index == 0)
+        return list_ptr->ul_front->ul_data[0];
+    if (pos_index == LLPOSITION_BACK || pos_index == list_ptr->ul_entry_count - 1)
+        return list_ptr->ul_back->ul_data[list_ptr->ul_back->ul_count - 1];
+    if (pos_index < 0 || pos_index >= list_ptr->ul_entry_count)
+        return NULL;
+
+    int off;
+    ullist_block_t *blk = locate(list_ptr, pos_index, &off);
+    assert(blk && blk->ul_data[off]);
+    return blk->ul_data[off];
+}
+
+ullist_t *ullist_construct(int (*fcomp)(const data_t *, const data_t *))
+{
+    ullist_t *L = (ullist_t *) malloc(sizeof(ullist_t));
+    assert(L);
+    L->ul_front = NULL;
+    L->ul_back = NULL;
+    L->ul_entry_count = 0;
+    L->ul_block_count = 0;
+    L->compare_fun = fcomp;
+    L->ul_sorted_state = (fcomp ? ULLIST_SORTED : ULLIST_UNSORTED);
+    return L;
+}
+
+void ullist_destruct(ullist_t *list_ptr)
+{
+    assert(list_ptr);
+    ullist_block_t *blk = list_ptr->ul_front;
+    while (blk) {
+        ullist_block_t *nxt = blk->ul_next;
+        for (int i = 0; i < blk->ul_count; i++) free(blk->ul_data[i]);
+        free(blk);
+        blk = nxt;
+    }
+    free(list_ptr);
+}
+
+data_t *ullist_elem_find(ullist_t *list_ptr, data_t *elem_ptr, int *pos_index,
+                         int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(list_ptr && pos_index);
+    *pos_index = -1;
+    int idx = 0;
+    for (ullist_block_t *blk = list_ptr->ul_front; blk; blk = blk->ul_next) {
+        for (int i = 0; i < blk->ul_count; i++, idx++) {
+            if (fcomp(elem_ptr, blk->ul_data[i]) == 0) {
+                *pos_index = idx;
+                return blk->ul_data[i];
+            }
+        }
+    }
+    return NULL;
+}
+
+int ullist_entries(ullist_t *list_ptr)
+{
+    assert(list_ptr && list_ptr->ul_entry_count >= 0);
+    return list_ptr->ul_entry_count;
+}
+
+void ullist_insert(ullist_t *list_ptr, data_t *elem_ptr, int pos_index)
+{
+    assert(list_ptr);
+    assert(pos_index == LLPOSITION_FRONT || pos_index == LLPOSITION_BACK || pos_index >= 0);
+
+    int n = list_ptr->ul_entry_count;
+    if (pos_index == LLPOSITION_FRONT) pos_index = 0;
+    if (pos_index == LLPOSITION_BACK || pos_index > n) pos_index = n;
+
+    if (n == 0) {
+        insert_at(list_ptr, NULL, 0, elem_ptr);
+    } else if (pos_index == n) {
+        insert_at(list_ptr, list_ptr->ul_back, list_ptr->ul_back->ul_count, elem_ptr);
+    } else {
+        int off;
+        ullist_block_t *blk = locate(list_ptr, pos_index, &off);
+        insert_at(list_ptr, blk, off, elem_ptr);
+    }
+    if (list_ptr->ul_sorted_state == ULLIST_SORTED) list_ptr->ul_sorted_state = ULLIST_UNSORTED;
+}
+
+void ullist_insert_sorted(ullist_t *list_ptr, data_t *elem_ptr)
+{
+    assert(list_ptr && list_ptr->compare_fun && list_ptr->ul_sorted_state == ULLIST_SORTED);
+
+    for (ullist_block_t *blk = list_ptr->ul_front; blk; blk = blk->ul_next) {
+        /* elem does not precede the block's last entry: skip whole block */
+        if (list_ptr->compare_fun(elem_ptr, blk->ul_data[blk->ul_count - 1]) != 1)
+            continue;
+        for (int i = 0; i < blk->ul_count; i++) {
+            if (list_ptr->compare_fun(elem_ptr, blk->ul_data[i]) == 1) {
+                insert_at(list_ptr, blk, i, elem_ptr);
+                return;
+            }
+        }
+    }
+    insert_at(list_ptr, list_ptr->ul_back,
+              list_ptr->ul_back ? list_ptr->ul_back->ul_count : 0, elem_ptr);
+}
+
+data_t *ullist_remove(ullist_t *list_ptr, int pos_index)
+{
+    assert(list_ptr);
+    assert(pos_index == LLPOSITION_FRONT || pos_index == LLPOSITION_BACK || pos_index >= 0);
+
+    int n = list_ptr->ul_entry_count;
+    if (n == 0) return NULL;
+    if (pos_index == LLPOSITION_FRONT) pos_index = 0;
+    if (pos_index == LLPOSITION_BACK) pos_index = n - 1;
+    if (pos_index >= n) return NULL;
+
+    int off;
+    ullist_block_t *blk = locate(list_ptr, pos_index, &off);
+    data_t *ret = blk->ul_data[off];
+    memmove(&blk->ul_data[off], &blk->ul_data[off + 1],
+            (blk->ul_count - off - 1) * sizeof(data_t *));
+    blk->ul_count--;
+    list_ptr->ul_entry_count--;
+
+    if (blk->ul_count == 0) {
+        block_unlink(list_ptr, blk);
+        free(blk);
+    } else if (blk->ul_count < ULLIST_BLOCK_CAP / 2 && blk->ul_next &&
+               blk->ul_count + blk->ul_next->ul_count <= ULLIST_BLOCK_CAP) {
+        ullist_block_t *nxt = blk->ul_next;
+        memcpy(&blk->ul_data[blk->ul_count], nxt->ul_data, nxt->ul_count * sizeof(data_t *));
+        blk->ul_count += nxt->ul_count;
+        block_unlink(list_ptr, nxt);
+        free(nxt);
+    }
+    return ret;
+}
+
+/* ===== sorting ===== */
+
+void ullist_sort(ullist_t *list_ptr, int sort_type,
+                 int (*fcomp)(const data_t *, const data_t *))
+{
+    assert(list_ptr && fcomp);
+    (void) sort_type;
+    list_ptr->compare_fun = fcomp;
+    list_ptr->ul_sorted_state = ULLIST_SORTED;
+    if (list_ptr->ul_entry_count <= 1) return;
+
+    /* each block, insertion sorted in place, is a run; pending[i] holds a
+     * run merged from 2^i of them, so runs combine like a binary counter
+     */
+    ullist_block_t *pending[ULLIST_MERGE_LEVELS] = {NULL};
+    ullist_block_t *spare = NULL;
+    ullist_block_t *blk = list_ptr->ul_front;
+    while (blk) {
+        ullist_block_t *run = blk;
+        blk = blk->ul_next;
+        run->ul_next = NULL;
+        block_sort(run, fcomp);
+        int i = 0;
+        for (; pending[i]; i++) {
+            assert(i + 1 < ULLIST_MERGE_LEVELS);
+            run = merge_runs(pending[i], run, fcomp, &spare);
+            pending[i] = NULL;
+        }
+        pending[i] = run;
+    }
+    ullist_block_t *run = NULL;
+    for (int i = 0; i < ULLIST_MERGE_LEVELS; i++)
+        if (pending[i]) run = run ? merge_runs(pending[i], run, fcomp, &spare) : pending[i];
+    while (spare) {
+        ullist_block_t *dead = spare;
+        spare = spare->ul_next;
+        free(dead);
+    }
+
+    /* merges only set ul_next; restore the back links and the header */
+    ullist_block_t *prev = NULL;
+    int blocks = 0;
+    for (blk = run; blk; prev = blk, blk = blk->ul_next) {
+        blk->ul_prev = prev;
+        blocks++;
+    }
+    list_ptr->ul_front = run;
+    list_ptr->ul_back = prev;
+    list_ptr->ul_block_count = blocks;
+}
+
+/* ===== helpers ===== */
+
+static ullist_block_t *block_new(void)
+{
+    ullist_block_t *blk = (ullist_block_t *) malloc(sizeof(ullist_block_t));
+    assert(blk);
+    blk->ul_prev = blk->ul_next = NULL;
+    blk->ul_count = 0;
+    return blk;
+}
+
+/* link blk after prev (prev == NULL links at the front) */
+static void block_link_after(ullist_t *L, ullist_block_t *prev, ullist_block_t *blk)
+{
+    blk->ul_prev = prev;
+    blk->ul_next = prev ? prev->ul_next : L->ul_front;
+    if (blk->ul_next) blk->ul_next->ul_prev = blk; else L->ul_back = blk;
+    if (prev) prev->ul_next = blk; else L->ul_front = blk;
+    L->ul_block_count++;
+}
+
+static void block_unlink(ullist_t *L, ullist_block_t *blk)
+{
+    if (blk->ul_prev) blk->ul_prev->ul_next = blk->ul_next; else L->ul_front = blk->ul_next;
+    if (blk->ul_next) blk->ul_next->ul_prev = blk->ul_prev; else L->ul_back = blk->ul_prev;
+    L->ul_block_count--;
+}
+
+/* find the block holding element pos_index, walking from the nearer end
+ * and skipping whole blocks by count
+ */
+static ullist_block_t *locate(ullist_t *L, int pos_index, int *offset)
+{
+    ullist_block_t *blk;
+    if (pos_index <= L->ul_entry_count / 2) {
+        blk = L->ul_front;
+        while (pos_index >= blk->ul_count) {
+            pos_index -= blk->ul_count;
+            blk = blk->ul_next;
+        }
+    } else {
+        int from_back = L->ul_entry_count - 1 - pos_index;
+        blk = L->ul_back;
+        while (from_back >= blk->ul_count) {
+            from_back -= blk->ul_count;
+            blk = blk->ul_prev;
+        }
+        pos_index = blk->ul_count - 1 - from_back;
+    }
+    *offset = pos_index;
+    return blk;
+}
+
+/* insert elem_ptr at offset off of blk, splitting blk when it is full;
+ * blk == NULL means the list is empty
+ */
+static void insert_at(ullist_t *L, ullist_block_t *blk, int off, data_t *elem_ptr)
+{
+    if (!blk) {
+        blk = block_new();
+        block_link_after(L, NULL, blk);
+        off = 0;
+    } else if (blk->ul_count == ULLIST_BLOCK_CAP) {
+        if (off == ULLIST_BLOCK_CAP && (!blk->ul_next || blk->ul_next->ul_count == ULLIST_BLOCK_CAP)) {
+            /* appending past a full block: start a fresh one */
+            ullist_block_t *fresh = block_new();
+            block_link_after(L, blk, fresh);
+            blk = fresh;
+            off = 0;
+        } else if (off == ULLIST_BLOCK_CAP) {
+            blk = blk->ul_next;
+            memmove(&blk->ul_data[1], &blk->ul_data[0], blk->ul_count * sizeof(data_t *));
+            blk->ul_data[0] = elem_ptr;
+            blk->ul_count++;
+            L->ul_entry_count++;
+            return;
+        } else {
+            ullist_block_t *half = block_new();
+            int keep = ULLIST_BLOCK_CAP / 2;
+            half->ul_count = ULLIST_BLOCK_CAP - keep;
+            memcpy(half->ul_data, &blk->ul_data[keep], half->ul_count * sizeof(data_t *));
+            blk->ul_count = keep;
+            block_link_after(L, blk, half);
+            if (off > keep) { blk = half; off -= keep; }
+        }
+    }
+    memmove(&blk->ul_data[off + 1], &blk->ul_data[off], (blk->ul_count - off) * sizeof(data_t *));
+    blk->ul_data[off] = elem_ptr;
+    blk->ul_count++;
+    L->ul_entry_count++;
+}
+
+/* stable insertion sort of one block's pointers */
+static void block_sort(ullist_block_t *blk, int (*fcomp)(const data_t *, const data_t *))
+{
+    data_t **d = blk->ul_data;
+    for (int i = 1; i < blk->ul_count; i++) {
+        data_t *x = d[i];
+        int j = i;
+        while (j > 0 && fcomp(x, d[j-1]) > 0) { d[j] = d[j-1]; j--; }
+        d[j] = x;
+    }
+}
+
+/* merge the sorted block chains a (the earlier run) and b into one chain
+ * of full blocks, the last possibly partial; ties take a, so the merge is
+ * stable.  A drained input block goes on *spare and is refilled as output,
+ * so a merge needs at most one block beyond its inputs.
+ */
+static ullist_block_t *merge_runs(ullist_block_t *a, ullist_block_t *b,
+                                  int (*fcomp)(const data_t *, const data_t *),
+                                  ullist_block_t **spare)
+{
+    ullist_block_t *head = NULL, *out = NULL;
+    int ia = 0, ib = 0;
+    while (a || b) {
+        data_t *x;
+        if (a && (b == NULL || fcomp(b->ul_data[ib], a->ul_data[ia]) <= 0)) {
+            x = a->ul_data[ia++];
+            if (ia == a->ul_count) {
+                ullist_block_t *next = a->ul_next;
+                a->ul_next = *spare;
+                *spare = a;
+                a = next;
+                ia = 0;
+            }
+        } else {
+            x = b->ul_data[ib++];
+            if (ib == b->ul_count) {
+                ullist_block_t *next = b->ul_next;
+                b->ul_next = *spare;
+                *spare = b;
+                b = next;
+                ib = 0;
+            }
+        }
+        if (out == NULL || out->ul_count == ULLIST_BLOCK_CAP) {
+            ullist_block_t *fresh = *spare;
+            if (fresh) *spare = fresh->ul_next;
+            else       fresh = block_new();
+            fresh->ul_count = 0;
+            fresh->ul_next = NULL;
+            if (out) out->ul_next = fresh; else head = fresh;
+            out = fresh;
+        }
+        out->ul_data[out->ul_count++] = x;
+    }
+    return head;
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,51 @@
+/* ullist.h
+ * Unrolled (chunked) list ADT
+ *
+ * Same operations as llist.h, but each node holds a small block of
+ * data_t pointers.  Traversal chases one pointer per block instead of one
+ * per element, and positional operations skip whole blocks by count.
+ */
+#ifndef ULLIST_H
+#define ULLIST_H
+
+#include "datatypes.h"
+#include "llist.h"     /* LLPOSITION_FRONT / LLPOSITION_BACK */
+
+/* 13 pointers + count + links fills a 128-byte node on 64-bit builds */
+#define ULLIST_BLOCK_CAP 13
+
+typedef struct ullist_block_tag {
+    struct ullist_block_tag *ul_prev;
+    struct ullist_block_tag *ul_next;
+    int ul_count;
+    data_t *ul_data[ULLIST_BLOCK_CAP];
+} ullist_block_t;
+
+typedef struct ullist_header_tag {
+    ullist_block_t *ul_front;
+    ullist_block_t *ul_back;
+    int ul_entry_count;
+    int ul_block_count;
+    int ul_sorted_state;  /* private flag used only by ullist.c */
+    int (*compare_fun)(const data_t *, const data_t *);
+} ullist_t;
+
+data_t *   ullist_access(ullist_t *list_ptr, int pos_index);
+ullist_t * ullist_construct(int (*fcomp)(const data_t *, const data_t *));
+void       ullist_destruct(ullist_t *list_ptr);
+data_t *   ullist_elem_find(ullist_t *list_ptr, data_t *elem_ptr, int *pos_index,
+                            int (*fcomp)(const data_t *, const data_t *));
+int        ullist_entries(ullist_t *list_ptr);
+void       ullist_insert(ullist_t *list_ptr, data_t *elem_ptr, int pos_index);
+void       ullist_insert_sorted(ullist_t *list_ptr, data_t *elem_ptr);
+data_t *   ullist_remove(ullist_t *list_ptr, int pos_index);
+
+/* Blockwise stable sort: each block is insertion sorted in place, then
+ * the blocks are merged bottom-up as runs, block chain into block chain,
+ * leaving every block full except possibly the last.  There is no flat
+ * array of the list.  sort_type is ignored: every type runs this sort.
+ */
+void       ullist_sort(ullist_t *list_ptr, int sort_type,
+                       int (*fcomp)(const data_t *, const data_t *));
+
+#endif
@@ -9,4 +9,23 @@ valgrind --leak-check=yes ./lab3 < ./tests/t02recsel > gradingout_t02recsel 2> g
 valgrind --leak-check=yes ./lab3 < ./tests/t03itersel > gradingout_t03itersel 2> gradingout_valt03itersel
 valgrind --leak-check=yes ./lab3 < ./tests/t04merge > gradingout_t04merge 2> gradingout_valt04merge
 valgrind --leak-check=yes ./lab3 < ./tests/t05qsort > gradingout_t05qsort 2> gradingout_valt05qsort
+valgrind --leak-check=yes ./lab3 < ./tests/t06stable > gradingout_t06stable 2> gradingout_valt06stable
+valgrind --leak-check=yes ./lab3 -p 2 -b 3 < ./tests/t06stable > gradingout_t06pipe 2> gradingout_valt06pipe
+valgrind --leak-check=yes ./lab3 < ./tests/t07simd > gradingout_t07simd 2> gradingout_valt07simd
+valgrind --leak-check=yes ./lab3 < ./tests/t08pdq > gradingout_t08pdq 2> gradingout_valt08pdq
+valgrind --leak-check=yes ./lab3 < ./tests/t09async > gradingout_t09async 2> gradingout_valt09async
+valgrind --leak-check=yes ./lab3 < ./tests/t10persist > gradingout_t10persist 2> gradingout_valt10persist
 
+valgrind --leak-check=yes ./lab3 < ./tests/t11extsort > gradingout_t11extsort 2> gradingout_valt11extsort
+valgrind --leak-check=yes ./extsort -m 1K -k 2 < ./tests/t11extsort > gradingout_t11extsort_ext 2> gradingout_valt11extsort_ext
+valgrind --leak-check=yes ./lab3 < ./tests/t12window > gradingout_t12window 2> gradingout_valt12window
+valgrind --leak-check=yes ./lab3 -H < ./tests/t13hist 2> gradingout_valt13hist_counts | awk -F'\t' 'NF == 7 { print $1 "\t" $2; next } { print }' > gradingout_t13hist_counts
+valgrind --leak-check=yes ./lab3 -M < ./tests/t14mem > gradingout_t14mem 2> gradingout_valt14mem
+valgrind --leak-check=yes ./lab3 -d < ./tests/t15dual > gradingout_t15dual_d 2> gradingout_valt15dual_d
+valgrind --leak-check=yes ./lab3 < ./tests/t16dump > gradingout_t16dump 2> gradingout_valt16dump
+od -An -td4 -w32 -v gradingout_t16dump.bin >> gradingout_t16dump
+valgrind --leak-check=yes ./lab3 < ./tests/t17benchall > gradingout_t17benchall 2> gradingout_valt17benchall
+valgrind --leak-check=yes ./lab3 -d < ./tests/t18cold > gradingout_t18cold_d 2> gradingout_valt18cold_d
+valgrind --leak-check=yes ./listcheck ullist > gradingout_t19ullist 2> gradingout_valt19ullist
+valgrind --leak-check=yes ./listcheck ilist > gradingout_t20ilist 2> gradingout_valt20ilist
+valgrind --leak-check=yes ./listcheck heap > gradingout_t21heap 2> gradingout_valt21heap
@@ -0,0 +1,182 @@
+/* workload.c
+ * ECE 2230 Fall 2025
+ * MP3 — key distributions for geninput and bench
+ *
+ * Purpose:
+ *   The generators behind geninput's list types.  Types 1-3 are the
+ *   original random, ascending and descending lists, moved here unchanged.
+ *   The rest model real feeds: Zipf-skewed generators, time-ordered input
+ *   with a few late records, heavy repeats, and the classic adversarial
+ *   shapes for sorts (organ pipe, sawtooth runs, all keys equal).
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include "workload.h"
+
+static const char *names[WORKLOAD_NTYPES + 1] = {
+    NULL, "random", "ascending", "descending", "zipf", "nearly",
+    "fewunique", "organpipe", "sawtooth", "equal",
+};
+
+/* ===== private helpers ===== */
+static void gen_random(int n, int unique_ip, workload_emit_fn emit, void *arg);
+static void gen_zipf(int n, double s, workload_emit_fn emit, void *arg);
+static void gen_nearly(int n, int swaps, workload_emit_fn emit, void *arg);
+
+int workload_generate(int type, int n, int unique_ip, double param, long seed,
+                      workload_emit_fn emit, void *arg)
+{
+    assert(n > 0 && emit);
+    srand48(seed);
+
+    int i;
+    switch (type) {
+    case WORKLOAD_RANDOM:
+        gen_random(n, unique_ip, emit, arg);
+        break;
+    case WORKLOAD_ASCENDING:
+        for (i = 0; i < n; i++) emit(i + 1, i + n, arg);
+        break;
+    case WORKLOAD_DESCENDING:
+        for (i = 0; i < n; i++) emit(n - i, 2 * n - i, arg);
+        break;
+    case WORKLOAD_ZIPF:
+        gen_zipf(n, param > 0 ? param : 1.0, emit, arg);
+        break;
+    case WORKLOAD_NEARLY:
+        gen_nearly(n, param > 0 ? (int) param : (n / 100 > 0 ? n / 100 : 1), emit, arg);
+        break;
+    case WORKLOAD_FEW_UNIQUE: {
+        int distinct = param > 0 ? (int) param : 8;
+        for (i = 0; i < n; i++) {
+            int key = (int) (distinct * drand48()) + 1;
+            emit(key, key + n, arg);
+        }
+        break;
+    }
+    case WORKLOAD_ORGAN_PIPE:
+        for (i = 0; i < n; i++) {
+            int key = (i < (n + 1) / 2) ? i + 1 : n - i;
+            emit(key, key + n, arg);
+        }
+        break;
+    case WORKLOAD_SAWTOOTH: {
+        int runs = param > 0 ? (int) param : 8;
+        int len = (n + runs - 1) / runs;
+        for (i = 0; i < n; i++) emit(i % len + 1, i % len + 1 + n, arg);
+        break;
+    }
+    case WORKLOAD_ALL_EQUAL:
+        for (i = 0; i < n; i++) emit(1, n + 1, arg);
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+const char *workload_name(int type)
+{
+    return (type >= 1 && type <= WORKLOAD_NTYPES) ? names[type] : NULL;
+}
+
+int workload_lookup(const char *name)
+{
+    assert(name);
+    for (int t = 1; t <= WORKLOAD_NTYPES; t++)
+        if (strcmp(name, names[t]) == 0) return t;
+    char *end;
+    long t = strtol(name, &end, 10);
+    return (*name && *end == '\0' && t >= 1 && t <= WORKLOAD_NTYPES) ? (int) t : -1;
+}
+
+/* ===== helpers ===== */
+
+/* geninput's type 1: a few planted extremes among uniform keys, or a
+ * random permutation of the ips when duplicates are not wanted
+ */
+static void gen_random(int n, int unique_ip, workload_emit_fn emit, void *arg)
+{
+    int addr_range = n * 0.5;
+    int i;
+    if (!unique_ip) {
+        for (i = 0; i < n; i++) {
+            if ((n >= 8) && (i == n/4 || i == n/2 || i == 3*n/4)) {
+                emit(n, n, arg);
+            } else if ((n >= 9) && (i == n/3 || i == 2*n/3)) {
+                emit(0, 0, arg);
+            } else {
+                int gen_id = (int) (addr_range * drand48()) + 1;
+                int ip = (int) (10*n * drand48()) + n + 1;
+                emit(gen_id, ip, arg);
+            }
+        }
+    } else {
+        int *narray = (int *) malloc(n * sizeof(int));
+        assert(narray);
+        for (i = 0; i < n; i++)
+            narray[i] = i;
+        for (i = 0; i < n; i++) {
+            int key = (int) (drand48() * (n - i)) + i;
+            assert(i <= key && key < n);
+            int temp = narray[i]; narray[i] = narray[key]; narray[key] = temp;
+            emit(i + 1, narray[i] + 1, arg);
+        }
+        free(narray);
+    }
+}
+
+/* n/2 generators; the rank-r one fires with probability proportional to
+ * 1/r^s.  Ranks map to ids through a random permutation so the busy
+ * generators are not also the smallest ids.
+ */
+static void gen_zipf(int n, double s, workload_emit_fn emit, void *arg)
+{
+    int m = n / 2 > 0 ? n / 2 : 1;
+    double *cdf = (double *) malloc(m * sizeof(double));
+    int *id = (int *) malloc(m * sizeof(int));
+    assert(cdf && id);
+
+    double total = 0.0;
+    for (int r = 0; r < m; r++) {
+        total += 1.0 / pow(r + 1, s);
+        cdf[r] = total;
+        id[r] = r + 1;
+    }
+    for (int r = m - 1; r > 0; r--) {
+        int j = (int) (drand48() * (r + 1));
+        int temp = id[r]; id[r] = id[j]; id[j] = temp;
+    }
+    for (int i = 0; i < n; i++) {
+        double u = drand48() * total;
+        int lo = 0, hi = m - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1; else hi = mid;
+        }
+        emit(id[lo], id[lo] + n, arg);
+    }
+    free(cdf);
+    free(id);
+}
+
+/* 1..n with `swaps` random pairs exchanged, like a time-ordered feed
+ * with a few late arrivals
+ */
+static void gen_nearly(int n, int swaps, workload_emit_fn emit, void *arg)
+{
+    int *key = (int *) malloc(n * sizeof(int));
+    assert(key);
+    for (int i = 0; i < n; i++) key[i] = i + 1;
+    for (int k = 0; k < swaps; k++) {
+        int a = (int) (drand48() * n), b = (int) (drand48() * n);
+        int temp = key[a]; key[a] = key[b]; key[b] = temp;
+    }
+    for (int i = 0; i < n; i++) emit(key[i], key[i] + n, arg);
+    free(key);
+}
+
+/* vi:set ts=8 sts=4 sw=4 et: */
@@ -0,0 +1,44 @@
+/* workload.h
+ * Key distributions for geninput and the benchmark driver
+ *
+ * workload_generate produces n (generator_id, dest_ip_addr) pairs in one
+ * of the distributions below and hands each pair to a callback, in list
+ * order.  geninput prints them as APPENDREAR lines; bench inserts them
+ * straight into a list so its timings skip the pipe and the parser.
+ *
+ * Types 1-3 are geninput's original lists and draw from drand48 in the
+ * same order, so a given seed still produces the same file.  The newer
+ * types derive both fields from one key (dest_ip_addr = key + n), so
+ * records with equal keys are identical and the printed order after a
+ * sort does not depend on the sort being stable.
+ */
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#define WORKLOAD_RANDOM      1  /* uniform; unique ips when unique_ip is set */
+#define WORKLOAD_ASCENDING   2
+#define WORKLOAD_DESCENDING  3
+#define WORKLOAD_ZIPF        4  /* param: exponent s (default 1.0) */
+#define WORKLOAD_NEARLY      5  /* ascending, then param random swaps (default n/100) */
+#define WORKLOAD_FEW_UNIQUE  6  /* param distinct keys (default 8) */
+#define WORKLOAD_ORGAN_PIPE  7  /* up to the middle, then back down */
+#define WORKLOAD_SAWTOOTH    8  /* param ascending runs (default 8) */
+#define WORKLOAD_ALL_EQUAL   9
+#define WORKLOAD_NTYPES      9
+
+/* receives each record in order; arg is passed through */
+typedef void (*workload_emit_fn)(int generator_id, int dest_ip_addr, void *arg);
+
+/* seeds drand48 and emits n records of the given type; param <= 0 picks
+ * the type's default.  Returns 0, or -1 for an unknown type.
+ */
+int          workload_generate(int type, int n, int unique_ip, double param, long seed,
+                               workload_emit_fn emit, void *arg);
+
+/* short name of a type ("zipf", "nearly", ...), or NULL */
+const char * workload_name(int type);
+
+/* type for a name or a number in 1..WORKLOAD_NTYPES, else -1 */
+int          workload_lookup(const char *name);
+
+#endif